@@ -0,0 +1,62 @@
+// Copyright (c) Daniel Marshall.
+// SPDX-License-Identifier: BSL-1.0
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include <dpm/batcher.h>
+
+// Throughput of a batcher feeding a cheap sink at a range of batch sizes. Small batches pay for a hand over to the
+// sink thread on nearly every item; larger ones amortise it until the sink's work dominates.
+
+namespace
+{
+    constexpr std::uint64_t items = 1 << 20;
+
+    template <std::size_t N>
+    void run()
+    {
+        std::uint64_t checksum = 0;
+        auto sink = [&](dpm::static_vector<std::uint64_t, N>& batch) {
+            for (auto value : batch)
+            {
+                checksum += value;
+            }
+        };
+
+        const auto start = std::chrono::steady_clock::now();
+        typename dpm::batcher<std::uint64_t, N, decltype(sink)>::stats_type stats;
+        {
+            dpm::batcher<std::uint64_t, N, decltype(sink)> b(sink);
+            for (std::uint64_t i = 0; i < items; ++i)
+            {
+                b.push(i);
+            }
+            b.flush();
+            b.wait();
+            stats = b.stats();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        if (checksum != items * (items - 1) / 2)
+        {
+            std::printf("bad checksum\n");
+        }
+        const auto mean_latency =
+            std::chrono::duration<double, std::micro>(stats.total_flush_latency).count() / double(stats.batches);
+        const auto wait = std::chrono::duration<double, std::milli>(stats.producer_wait).count();
+        std::printf("%6zu %12.1f %18.2f %18.1f\n", N, double(items) / elapsed.count() / 1e6, mean_latency, wait);
+    }
+}
+
+int main()
+{
+    std::printf("%6s %12s %18s %18s\n", "batch", "Mitems/s", "flush latency us", "producer wait ms");
+    run<1>();
+    run<8>();
+    run<64>();
+    run<512>();
+    run<4096>();
+    run<32768>();
+}
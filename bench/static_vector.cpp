@@ -0,0 +1,102 @@
+// Copyright (c) Daniel Marshall.
+// SPDX-License-Identifier: BSL-1.0
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+
+#include <dpm/static_vector.h>
+
+// Built both as sv_bench and, with DPM_HARDENED, as sv_bench_hardened. Compare the two to see what the checks cost.
+
+namespace
+{
+    template <class T>
+    void do_not_optimize(T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : "+m"(value) : : "memory");
+#else
+        static volatile T sink;
+        sink = value;
+#endif
+    }
+
+    template <class Fn>
+    void run(const char* name, std::size_t ops_per_iteration, Fn fn)
+    {
+        constexpr int iterations = 20'000;
+        for (int i = 0; i < iterations / 10; ++i)
+        {
+            fn();
+        }
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            fn();
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        std::printf("%-24s %8.3f ns/op\n", name, elapsed.count() / (double(iterations) * double(ops_per_iteration)));
+    }
+
+    constexpr std::size_t capacity = 1024;
+}
+
+int main()
+{
+#if defined(DPM_HARDENED)
+    std::printf("static_vector (hardened)\n");
+#else
+    std::printf("static_vector\n");
+#endif
+
+    dpm::static_vector<std::uint32_t, capacity> sv;
+
+    run("push_back", capacity, [&] {
+        sv.clear();
+        for (std::uint32_t i = 0; i < capacity; ++i)
+        {
+            sv.push_back(i);
+        }
+        do_not_optimize(sv);
+    });
+
+    run("operator[]", capacity, [&] {
+        std::uint32_t sum = 0;
+        for (std::size_t i = 0; i < sv.size(); ++i)
+        {
+            sum += sv[i];
+        }
+        do_not_optimize(sum);
+    });
+
+    run("operator[] (strided)", capacity, [&] {
+        std::uint32_t sum = 0;
+        for (std::size_t i = 0; i < capacity; ++i)
+        {
+            sum += sv[(i * 7) % sv.size()];
+        }
+        do_not_optimize(sum);
+    });
+
+    // Resizing trivial elements only stores the new size, so without hiding the sizes and keeping each store the whole
+    // loop folds away and this would only time an empty loop.
+    run("resize", 64, [&] {
+        for (std::size_t i = 0; i < 64; ++i)
+        {
+            auto size = static_cast<std::uint16_t>((i * 97) % capacity);
+            do_not_optimize(size);
+            sv.resize(size);
+            do_not_optimize(sv);
+        }
+    });
+
+    run("insert (near end)", 64, [&] {
+        sv.resize(capacity - 64);
+        for (std::uint32_t i = 0; i < 64; ++i)
+        {
+            sv.insert(sv.end() - 1, i);
+        }
+        do_not_optimize(sv);
+    });
+}
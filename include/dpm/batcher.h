@@ -0,0 +1,253 @@
+// Copyright (c) Daniel Marshall.
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "static_vector.h"
+
+// batcher needs the platform's thread library; the dpm::static_vector_parallel CMake target links it.
+
+namespace dpm
+{
+    template <class Duration>
+    struct batcher_stats
+    {
+        std::size_t batches = 0;
+        std::size_t items = 0;
+        // Why each batch was sent: it filled up, its deadline passed, or flush() was called.
+        std::size_t full_flushes = 0;
+        std::size_t deadline_flushes = 0;
+        std::size_t manual_flushes = 0;
+        std::size_t min_batch_size = 0;
+        std::size_t max_batch_size = 0;
+        // From handing a batch over until the sink has finished with it.
+        Duration last_flush_latency{};
+        Duration max_flush_latency{};
+        Duration total_flush_latency{};
+        // Time the producer spent blocked because the previous batch was still in the sink.
+        Duration producer_wait{};
+
+        [[nodiscard]] double mean_batch_size() const noexcept
+        {
+            return batches == 0 ? 0.0 : static_cast<double>(items) / static_cast<double>(batches);
+        }
+    };
+
+    // Accumulates items into a static_vector<T, N> and hands each batch to sink(batch&) on a background thread, once it
+    // is full or once the oldest item in it has waited max_delay (checked when items are added). There are two
+    // buffers, so the next batch fills while the sink processes the last one; the producer only waits if it fills the
+    // next batch before the sink is done.
+    //
+    // A single thread adds items. If the sink throws, the exception is rethrown from whichever call next hands over a
+    // batch or waits for the sink.
+    template <class T, std::size_t N, class Sink, class Clock = std::chrono::steady_clock>
+    class batcher
+    {
+    public:
+        using batch_type = static_vector<T, N>;
+        using clock = Clock;
+        using duration = typename Clock::duration;
+        using time_point = typename Clock::time_point;
+        using stats_type = batcher_stats<duration>;
+
+    private:
+        enum class flush_reason
+        {
+            full,
+            deadline,
+            manual
+        };
+
+        Sink sink_;
+        duration max_delay_;
+
+        batch_type buffers_[2];
+        // The producer only touches buffers_[filling_]; the worker only touches buffers_[1 - filling_] while pending_.
+        int filling_ = 0;
+        time_point deadline_{};
+
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        bool pending_ = false;
+        bool stopping_ = false;
+        time_point handed_over_{};
+        std::exception_ptr error_;
+        stats_type stats_;
+        std::thread worker_;
+
+        void work()
+        {
+            std::unique_lock lock(mutex_);
+            while (true)
+            {
+                cv_.wait(lock, [&] { return pending_ || stopping_; });
+                if (!pending_)
+                {
+                    return;
+                }
+                auto& batch = buffers_[1 - filling_];
+                lock.unlock();
+
+                std::exception_ptr error;
+                try
+                {
+                    std::invoke(sink_, batch);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                batch.clear();
+                const auto finished = Clock::now();
+
+                lock.lock();
+                const auto latency = finished - handed_over_;
+                stats_.last_flush_latency = latency;
+                stats_.max_flush_latency = std::max(stats_.max_flush_latency, latency);
+                stats_.total_flush_latency += latency;
+                if (error && !error_)
+                {
+                    error_ = error;
+                }
+                pending_ = false;
+                cv_.notify_all();
+            }
+        }
+
+        // Returns the exception from the last batch, if the sink threw one.
+        [[nodiscard]] std::exception_ptr wait_for_worker(std::unique_lock<std::mutex>& lock)
+        {
+            if (pending_)
+            {
+                const auto start = Clock::now();
+                cv_.wait(lock, [&] { return !pending_; });
+                stats_.producer_wait += Clock::now() - start;
+            }
+            return std::exchange(error_, nullptr);
+        }
+
+        void hand_over(flush_reason reason)
+        {
+            std::unique_lock lock(mutex_);
+            // The batch is handed over even if the previous one failed, so the producer always has room to carry on.
+            const auto error = wait_for_worker(lock);
+
+            auto& batch = buffers_[filling_];
+            const std::size_t size = batch.size();
+            stats_.min_batch_size = stats_.batches == 0 ? size : std::min(stats_.min_batch_size, size);
+            stats_.max_batch_size = std::max(stats_.max_batch_size, size);
+            ++stats_.batches;
+            stats_.items += size;
+            switch (reason)
+            {
+            case flush_reason::full: ++stats_.full_flushes; break;
+            case flush_reason::deadline: ++stats_.deadline_flushes; break;
+            case flush_reason::manual: ++stats_.manual_flushes; break;
+            }
+
+            filling_ = 1 - filling_;
+            pending_ = true;
+            handed_over_ = Clock::now();
+            cv_.notify_all();
+            lock.unlock();
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        void added()
+        {
+            const auto& batch = buffers_[filling_];
+            if (batch.size() == N)
+            {
+                hand_over(flush_reason::full);
+                return;
+            }
+            const auto now = Clock::now();
+            if (batch.size() == 1)
+            {
+                deadline_ = max_delay_ == duration::max() ? time_point::max() : now + max_delay_;
+            }
+            if (now >= deadline_)
+            {
+                hand_over(flush_reason::deadline);
+            }
+        }
+
+    public:
+        explicit batcher(Sink sink, duration max_delay = duration::max())
+            : sink_(std::move(sink)), max_delay_(max_delay), worker_([this] { work(); })
+        {
+        }
+        batcher(const batcher&) = delete;
+        batcher& operator=(const batcher&) = delete;
+
+        // Sends whatever is left and waits for the sink. Exceptions from the sink at this point are discarded.
+        ~batcher()
+        {
+            try
+            {
+                flush();
+            }
+            catch (...)
+            {
+            }
+            {
+                std::lock_guard lock(mutex_);
+                stopping_ = true;
+            }
+            cv_.notify_all();
+            worker_.join();
+        }
+
+        template <class... Args>
+        void emplace(Args&&... args)
+        {
+            buffers_[filling_].emplace_back(std::forward<Args>(args)...);
+            added();
+        }
+        void push(const T& value) { emplace(value); }
+        void push(T&& value) { emplace(std::move(value)); }
+
+        // Sends the current batch, if it has anything in it, without waiting for the sink to process it.
+        void flush()
+        {
+            if (!buffers_[filling_].empty())
+            {
+                hand_over(flush_reason::manual);
+            }
+        }
+        // Waits until the sink has processed every batch sent so far. Doesn't send the current batch.
+        void wait()
+        {
+            std::unique_lock lock(mutex_);
+            if (const auto error = wait_for_worker(lock))
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        // Items waiting in the batch that is currently filling.
+        [[nodiscard]] std::size_t pending_items() const noexcept { return buffers_[filling_].size(); }
+        [[nodiscard]] static constexpr std::size_t batch_capacity() noexcept { return N; }
+        [[nodiscard]] duration max_delay() const noexcept { return max_delay_; }
+
+        [[nodiscard]] stats_type stats() const
+        {
+            std::lock_guard lock(mutex_);
+            return stats_;
+        }
+    };
+
+}
@@ -0,0 +1,279 @@
+// Copyright (c) Daniel Marshall.
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "static_vector.h"
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DPM_HAS_MAPPED_STATIC_VECTOR_TABLE 1
+
+namespace dpm
+{
+    // Thrown when an existing file isn't a table of the expected record layout.
+    class mapped_table_format_error : public std::runtime_error
+    {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    // A fixed number of static_vector<T, N> records living directly in a memory mapped file. Records are accessed in
+    // place, so reopening a table is just a mmap; nothing is deserialised.
+    //
+    // The file starts with a header recording the layout it was written with, and open() refuses files whose layout
+    // doesn't match this instantiation. The layout is also dependent on the platform's endianness and ABI, so files
+    // aren't portable between platforms.
+    template <class T, std::size_t N>
+    class mapped_static_vector_table
+    {
+    public:
+        using record_type = static_vector<T, N>;
+        using value_type = record_type;
+        using reference = record_type&;
+        using const_reference = const record_type&;
+        using size_type = std::size_t;
+        using iterator = record_type*;
+        using const_iterator = const record_type*;
+
+        static_assert(std::is_trivially_copyable_v<record_type> && std::is_standard_layout_v<record_type>,
+            "Only tables of trivially copyable, standard layout static_vectors can be mapped.");
+
+        static constexpr std::uint64_t magic = 0x4c425456534d5044; // "DPMSVTBL" when read as little endian.
+        static constexpr std::uint32_t version = 1;
+
+    private:
+        struct header
+        {
+            std::uint64_t magic;
+            std::uint32_t version;
+            std::uint32_t data_offset;
+            std::uint64_t record_count;
+            std::uint64_t record_size;
+            std::uint64_t record_alignment;
+            std::uint64_t capacity;
+            std::uint64_t element_size;
+        };
+
+        static constexpr std::size_t data_offset =
+            (sizeof(header) + alignof(record_type) - 1) / alignof(record_type) * alignof(record_type);
+
+        int fd_ = -1;
+        std::byte* mapping_ = nullptr;
+        std::size_t mapping_size_ = 0;
+        std::size_t count_ = 0;
+
+        mapped_static_vector_table(int fd, std::byte* mapping, std::size_t mapping_size, std::size_t count) noexcept
+            : fd_(fd), mapping_(mapping), mapping_size_(mapping_size), count_(count)
+        {
+        }
+
+        [[noreturn]] static void throw_errno(const char* what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        [[nodiscard]] static header expected_header(std::size_t count) noexcept
+        {
+            return { magic, version, static_cast<std::uint32_t>(data_offset), count, sizeof(record_type),
+                alignof(record_type), N, sizeof(T) };
+        }
+
+        static mapped_static_vector_table map(int fd, std::size_t size, std::size_t count)
+        {
+            void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (mapping == MAP_FAILED)
+            {
+                const auto error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "mmap");
+            }
+            return { fd, static_cast<std::byte*>(mapping), size, count };
+        }
+
+        void sync(int flags) const
+        {
+            if (mapping_ != nullptr && ::msync(mapping_, mapping_size_, flags) != 0)
+            {
+                throw_errno("msync");
+            }
+        }
+
+    public:
+        // Creates (or truncates) the file at path to hold count empty records.
+        [[nodiscard]] static mapped_static_vector_table create(const std::filesystem::path& path, std::size_t count)
+        {
+            const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd == -1)
+            {
+                throw_errno("open");
+            }
+            const auto size = data_offset + count * sizeof(record_type);
+            if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+            {
+                const auto error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "ftruncate");
+            }
+
+            // ftruncate zero fills, and all zero bytes is an empty static_vector.
+            auto table = map(fd, size, count);
+            const auto h = expected_header(count);
+            std::memcpy(table.mapping_, &h, sizeof(h));
+            return table;
+        }
+
+        // Maps an existing table, throwing mapped_table_format_error if it was written with a different layout or holds
+        // a record with more than N elements.
+        [[nodiscard]] static mapped_static_vector_table open(const std::filesystem::path& path)
+        {
+            const int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+            if (fd == -1)
+            {
+                throw_errno("open");
+            }
+            struct stat st;
+            if (::fstat(fd, &st) != 0)
+            {
+                const auto error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "fstat");
+            }
+            const auto size = static_cast<std::size_t>(st.st_size);
+            header h;
+            if (size < sizeof(h) || ::pread(fd, &h, sizeof(h), 0) != static_cast<ssize_t>(sizeof(h)))
+            {
+                ::close(fd);
+                throw mapped_table_format_error("mapped_static_vector_table: file is too small to hold a header");
+            }
+
+            const auto expected = expected_header(h.record_count);
+            const char* problem = nullptr;
+            if (h.magic != expected.magic)
+            {
+                problem = "mapped_static_vector_table: bad magic number";
+            }
+            else if (h.version != expected.version)
+            {
+                problem = "mapped_static_vector_table: unsupported version";
+            }
+            else if (h.data_offset != expected.data_offset || h.record_size != expected.record_size ||
+                     h.record_alignment != expected.record_alignment || h.capacity != expected.capacity ||
+                     h.element_size != expected.element_size)
+            {
+                problem = "mapped_static_vector_table: record layout doesn't match";
+            }
+            // Checked by division first, so a corrupted count can't overflow the multiplication and pass.
+            else if (size < data_offset || h.record_count > (size - data_offset) / sizeof(record_type) ||
+                     size != data_offset + h.record_count * sizeof(record_type))
+            {
+                problem = "mapped_static_vector_table: file size doesn't match the record count";
+            }
+            if (problem != nullptr)
+            {
+                ::close(fd);
+                throw mapped_table_format_error(problem);
+            }
+            auto table = map(fd, size, static_cast<std::size_t>(h.record_count));
+            // Each record stores its own size, which a damaged or partly written file could have set past N.
+            for (const auto& record : table)
+            {
+                if (record.size() > N)
+                {
+                    throw mapped_table_format_error("mapped_static_vector_table: record size exceeds its capacity");
+                }
+            }
+            return table;
+        }
+
+        mapped_static_vector_table(const mapped_static_vector_table&) = delete;
+        mapped_static_vector_table& operator=(const mapped_static_vector_table&) = delete;
+        mapped_static_vector_table(mapped_static_vector_table&& other) noexcept
+            : fd_(std::exchange(other.fd_, -1)), mapping_(std::exchange(other.mapping_, nullptr)),
+              mapping_size_(std::exchange(other.mapping_size_, 0)), count_(std::exchange(other.count_, 0))
+        {
+        }
+        mapped_static_vector_table& operator=(mapped_static_vector_table&& other) noexcept
+        {
+            if (this != &other)
+            {
+                close();
+                fd_ = std::exchange(other.fd_, -1);
+                mapping_ = std::exchange(other.mapping_, nullptr);
+                mapping_size_ = std::exchange(other.mapping_size_, 0);
+                count_ = std::exchange(other.count_, 0);
+            }
+            return *this;
+        }
+        ~mapped_static_vector_table() { close(); }
+
+        // Unmaps the file. Changes reach the file eventually regardless; flush() first to be sure they're on disk.
+        void close() noexcept
+        {
+            if (mapping_ != nullptr)
+            {
+                ::munmap(mapping_, mapping_size_);
+                mapping_ = nullptr;
+            }
+            if (fd_ != -1)
+            {
+                ::close(fd_);
+                fd_ = -1;
+            }
+            mapping_size_ = 0;
+            count_ = 0;
+        }
+
+        // Blocks until all changes are written back to the file.
+        void flush() const { sync(MS_SYNC); }
+        // Schedules all changes to be written back to the file without waiting.
+        void flush_async() const { sync(MS_ASYNC); }
+
+        [[nodiscard]] bool is_open() const noexcept { return mapping_ != nullptr; }
+        [[nodiscard]] bool empty() const noexcept { return count_ == 0; }
+        [[nodiscard]] size_type size() const noexcept { return count_; }
+
+        [[nodiscard]] record_type* data() noexcept
+        {
+            return std::launder(reinterpret_cast<record_type*>(mapping_ + data_offset));
+        }
+        [[nodiscard]] const record_type* data() const noexcept
+        {
+            return std::launder(reinterpret_cast<const record_type*>(mapping_ + data_offset));
+        }
+
+        [[nodiscard]] iterator begin() noexcept { return data(); }
+        [[nodiscard]] const_iterator begin() const noexcept { return data(); }
+        [[nodiscard]] iterator end() noexcept { return data() + count_; }
+        [[nodiscard]] const_iterator end() const noexcept { return data() + count_; }
+
+        [[nodiscard]] reference operator[](std::size_t n) noexcept
+        {
+            DPM_ASSERT(n < count_);
+            return data()[n];
+        }
+        [[nodiscard]] const_reference operator[](std::size_t n) const noexcept
+        {
+            DPM_ASSERT(n < count_);
+            return data()[n];
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,308 @@
+// Copyright (c) Daniel Marshall.
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <version>
+
+#include "static_vector.h"
+
+#if defined(__cpp_lib_execution)
+#include <execution>
+#endif
+
+// Bulk operations for large static_vectors that split the work across threads. Elements are constructed directly into
+// the unused capacity, so nothing is staged in a temporary container. Each operation has an overload taking a standard
+// execution policy (where the standard library provides them); std::execution::seq and unseq run on the calling
+// thread, any other policy uses up to std::thread::hardware_concurrency() threads. The overloads without a policy run
+// on the calling thread.
+//
+// These need the platform's thread library; the dpm::static_vector_parallel CMake target links it.
+
+namespace dpm
+{
+    namespace detail
+    {
+        struct static_vector_access
+        {
+            // fill(p) must construct n elements at p, or throw having left none constructed.
+            template <class T, std::size_t N, class Fill>
+            static void append_uninitialized(static_vector<T, N>& v, std::size_t n, Fill fill)
+            {
+                DPM_ASSERT(v.size() + n <= v.capacity());
+                const std::size_t old_size = v.size_;
+                v.annotate(old_size, old_size + n);
+                try
+                {
+                    fill(v.data() + old_size);
+                }
+                catch (...)
+                {
+                    v.annotate(old_size + n, old_size);
+                    throw;
+                }
+                v.size_ = static_cast<typename static_vector<T, N>::size_type>(old_size + n);
+            }
+        };
+
+        // Upper bound on the number of threads used by a single operation.
+        inline constexpr std::size_t max_chunks = 64;
+        // Below this many elements per thread, starting threads costs more than it saves.
+        inline constexpr std::size_t min_chunk_size = 4096;
+
+        using task_errors = static_vector<std::exception_ptr, max_chunks>;
+
+        [[nodiscard]] inline std::size_t chunk_count(std::size_t n, bool parallel) noexcept
+        {
+            if (n == 0)
+            {
+                return 0;
+            }
+            if (!parallel || n < 2 * min_chunk_size)
+            {
+                return 1;
+            }
+            const std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+            return std::min({ threads, n / min_chunk_size, max_chunks });
+        }
+
+        [[nodiscard]] constexpr std::size_t chunk_begin(std::size_t n, std::size_t chunks, std::size_t i) noexcept
+        {
+            return n * i / chunks;
+        }
+
+        // Runs fn(0) ... fn(count - 1), the first on the calling thread and the rest on their own threads. Exceptions
+        // are captured per task rather than propagated, so callers can clean up after the tasks that did succeed.
+        template <class Fn>
+        [[nodiscard]] task_errors run_tasks(std::size_t count, Fn fn) noexcept
+        {
+            DPM_ASSERT(count <= max_chunks);
+            task_errors errors(static_cast<task_errors::size_type>(count));
+            auto run = [&](std::size_t i) noexcept {
+                try
+                {
+                    fn(i);
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            };
+
+            static_vector<std::thread, max_chunks> threads;
+            for (std::size_t i = 1; i < count; ++i)
+            {
+                try
+                {
+                    threads.emplace_back(run, i);
+                }
+                catch (...)
+                {
+                    // Couldn't start a thread, so do the work here instead.
+                    run(i);
+                }
+            }
+            if (count > 0)
+            {
+                run(0);
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            return errors;
+        }
+
+        inline void rethrow_first(const task_errors& errors)
+        {
+            for (const auto& error : errors)
+            {
+                if (error)
+                {
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+
+        // Constructs n elements at out with construct(pointer, index), split over chunks. If anything throws, every
+        // element that was constructed is destroyed before the first exception is rethrown.
+        template <class T, class Construct>
+        void construct_chunked(T* out, std::size_t n, bool parallel, Construct construct)
+        {
+            const auto chunks = chunk_count(n, parallel);
+            const auto errors = run_tasks(chunks, [&](std::size_t c) {
+                const auto first = chunk_begin(n, chunks, c);
+                const auto last = chunk_begin(n, chunks, c + 1);
+                auto i = first;
+                try
+                {
+                    for (; i != last; ++i)
+                    {
+                        construct(out + i, i);
+                    }
+                }
+                catch (...)
+                {
+                    std::destroy(out + first, out + i);
+                    throw;
+                }
+            });
+
+            if (ranges::any_of(errors, [](const auto& error) { return static_cast<bool>(error); }))
+            {
+                for (std::size_t c = 0; c < chunks; ++c)
+                {
+                    if (!errors[c])
+                    {
+                        std::destroy(out + chunk_begin(n, chunks, c), out + chunk_begin(n, chunks, c + 1));
+                    }
+                }
+                rethrow_first(errors);
+            }
+        }
+
+        template <class T, std::size_t N, std::random_access_iterator Iter, class UnaryOp>
+        void transform_append(bool parallel, static_vector<T, N>& v, Iter first, Iter last, UnaryOp& op)
+        {
+            const auto n = static_cast<std::size_t>(last - first);
+            static_vector_access::append_uninitialized(v, n, [&](T* out) {
+                construct_chunked(out, n, parallel, [&](T* p, std::size_t i) {
+                    std::construct_at(p, std::invoke(op, first[static_cast<std::iter_difference_t<Iter>>(i)]));
+                });
+            });
+        }
+
+        template <class T, std::size_t N, class Generator>
+        void generate_n_into(bool parallel, static_vector<T, N>& v, std::size_t n, Generator& gen)
+        {
+            static_vector_access::append_uninitialized(v, n, [&](T* out) {
+                construct_chunked(out, n, parallel, [&](T* p, std::size_t) { std::construct_at(p, gen()); });
+            });
+        }
+
+        template <class T, std::size_t N, class Init, class BinaryOp>
+        [[nodiscard]] Init reduce(bool parallel, const static_vector<T, N>& v, Init init, BinaryOp& op)
+        {
+            const std::size_t n = v.size();
+            const auto chunks = chunk_count(n, parallel);
+            std::optional<Init> partials[max_chunks];
+            rethrow_first(run_tasks(chunks, [&](std::size_t c) {
+                const auto first = chunk_begin(n, chunks, c);
+                const auto last = chunk_begin(n, chunks, c + 1);
+                Init partial = v[first];
+                for (auto i = first + 1; i != last; ++i)
+                {
+                    partial = std::invoke(op, std::move(partial), v[i]);
+                }
+                partials[c].emplace(std::move(partial));
+            }));
+
+            for (std::size_t c = 0; c < chunks; ++c)
+            {
+                init = std::invoke(op, std::move(init), std::move(*partials[c]));
+            }
+            return init;
+        }
+
+        template <class T, std::size_t N, class Compare>
+        void sort(bool parallel, static_vector<T, N>& v, Compare& comp)
+        {
+            const std::size_t n = v.size();
+            const auto chunks = chunk_count(n, parallel);
+            auto bound = [&](std::size_t c) { return v.begin() + chunk_begin(n, chunks, std::min(c, chunks)); };
+
+            rethrow_first(run_tasks(chunks, [&](std::size_t c) { std::sort(bound(c), bound(c + 1), comp); }));
+            // Merge neighbouring sorted runs pairwise until there's only one left.
+            for (std::size_t width = 1; width < chunks; width *= 2)
+            {
+                const auto merges = (chunks + 2 * width - 1) / (2 * width);
+                rethrow_first(run_tasks(merges, [&](std::size_t m) {
+                    const auto first = m * 2 * width;
+                    std::inplace_merge(bound(first), bound(first + width), bound(first + 2 * width), comp);
+                }));
+            }
+        }
+
+#if defined(__cpp_lib_execution)
+        template <class ExecutionPolicy>
+        concept execution_policy = std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>;
+
+        template <execution_policy ExecutionPolicy>
+        constexpr bool is_parallel_policy = !std::is_same_v<std::remove_cvref_t<ExecutionPolicy>,
+                                                std::execution::sequenced_policy> &&
+                                            !std::is_same_v<std::remove_cvref_t<ExecutionPolicy>,
+                                                std::execution::unsequenced_policy>;
+#endif
+    }
+
+    // Appends op(x) for each x in [first, last), constructing the results in place. If any call throws, v is left
+    // unchanged.
+    template <class T, std::size_t N, std::random_access_iterator Iter, class UnaryOp>
+    void transform_append(static_vector<T, N>& v, Iter first, Iter last, UnaryOp op)
+    {
+        detail::transform_append(false, v, first, last, op);
+    }
+
+    // Appends n elements constructed from gen(). If any call throws, v is left unchanged.
+    template <class T, std::size_t N, class Generator>
+    void generate_n_into(static_vector<T, N>& v, std::size_t n, Generator gen)
+    {
+        detail::generate_n_into(false, v, n, gen);
+    }
+
+    // Like std::reduce, op must be associative and commutative as the grouping and order of operations are unspecified.
+    template <class T, std::size_t N, class Init = T, class BinaryOp = std::plus<>>
+    [[nodiscard]] Init reduce(const static_vector<T, N>& v, Init init = Init{}, BinaryOp op = {})
+    {
+        return detail::reduce(false, v, std::move(init), op);
+    }
+
+    // Sorts each thread's share of v then merges the runs. Not stable.
+    template <class T, std::size_t N, class Compare = ranges::less>
+    void parallel_sort(static_vector<T, N>& v, Compare comp = {})
+    {
+        detail::sort(false, v, comp);
+    }
+
+#if defined(__cpp_lib_execution)
+    // As above, but with a parallel policy op may be called concurrently.
+    template <detail::execution_policy ExecutionPolicy, class T, std::size_t N, std::random_access_iterator Iter,
+        class UnaryOp>
+    void transform_append(ExecutionPolicy&&, static_vector<T, N>& v, Iter first, Iter last, UnaryOp op)
+    {
+        detail::transform_append(detail::is_parallel_policy<ExecutionPolicy>, v, first, last, op);
+    }
+
+    // As above, but with a parallel policy gen may be called concurrently.
+    template <detail::execution_policy ExecutionPolicy, class T, std::size_t N, class Generator>
+    void generate_n_into(ExecutionPolicy&&, static_vector<T, N>& v, std::size_t n, Generator gen)
+    {
+        detail::generate_n_into(detail::is_parallel_policy<ExecutionPolicy>, v, n, gen);
+    }
+
+    template <detail::execution_policy ExecutionPolicy, class T, std::size_t N, class Init = T,
+        class BinaryOp = std::plus<>>
+    [[nodiscard]] Init reduce(ExecutionPolicy&&, const static_vector<T, N>& v, Init init = Init{}, BinaryOp op = {})
+    {
+        return detail::reduce(detail::is_parallel_policy<ExecutionPolicy>, v, std::move(init), op);
+    }
+
+    template <detail::execution_policy ExecutionPolicy, class T, std::size_t N, class Compare = ranges::less>
+    void parallel_sort(ExecutionPolicy&&, static_vector<T, N>& v, Compare comp = {})
+    {
+        detail::sort(detail::is_parallel_policy<ExecutionPolicy>, v, comp);
+    }
+#endif
+
+}
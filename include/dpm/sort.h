@@ -0,0 +1,161 @@
+// Copyright (c) Daniel Marshall.
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "static_vector.h"
+
+namespace dpm
+{
+    namespace detail
+    {
+        // Capacities up to this are sorted with a sorting network when possible.
+        inline constexpr std::size_t max_network_size = 32;
+
+        struct comparator
+        {
+            std::uint8_t lo;
+            std::uint8_t hi;
+        };
+
+        // Batcher's odd-even merge sort for the next power of two up from N, dropping every comparator that touches an
+        // index >= N. Those positions would only ever hold +infinity padding, so the comparators are no-ops.
+        template <std::size_t N, class Out>
+        constexpr void odd_even_merge_sort(Out out)
+        {
+            std::size_t p2 = 1;
+            while (p2 < N)
+            {
+                p2 *= 2;
+            }
+            for (std::size_t p = 1; p < p2; p *= 2)
+            {
+                for (std::size_t k = p; k >= 1; k /= 2)
+                {
+                    for (std::size_t j = k % p; j + k < p2; j += 2 * k)
+                    {
+                        for (std::size_t i = 0; i < k && i + j + k < p2; ++i)
+                        {
+                            const auto lo = i + j;
+                            const auto hi = i + j + k;
+                            if (lo / (2 * p) == hi / (2 * p) && hi < N)
+                            {
+                                out(lo, hi);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        template <std::size_t N>
+        consteval std::size_t network_length()
+        {
+            std::size_t length = 0;
+            odd_even_merge_sort<N>([&](std::size_t, std::size_t) { ++length; });
+            return length;
+        }
+
+        template <std::size_t N>
+        consteval auto make_network()
+        {
+            std::array<comparator, network_length<N>()> network{};
+            std::size_t n = 0;
+            odd_even_merge_sort<N>([&](std::size_t lo, std::size_t hi) {
+                network[n++] = { static_cast<std::uint8_t>(lo), static_cast<std::uint8_t>(hi) };
+            });
+            return network;
+        }
+
+        template <std::size_t N>
+        inline constexpr auto sorting_network = make_network<N>();
+
+        template <class T>
+        inline constexpr T sort_sentinel =
+            std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+
+        template <class T, class Compare>
+        constexpr bool use_sorting_network =
+            std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+            (std::is_same_v<Compare, ranges::less> || std::is_same_v<Compare, std::less<>> ||
+                std::is_same_v<Compare, std::less<T>>);
+
+        // Written with min/max rather than a branch so it compiles to conditional moves or vector min/max.
+        template <class T>
+        constexpr void compare_exchange(T* data, std::size_t lo, std::size_t hi) noexcept
+        {
+            const T a = data[lo];
+            const T b = data[hi];
+            data[lo] = std::min(a, b);
+            data[hi] = std::max(a, b);
+        }
+
+        template <std::size_t N, class T>
+        constexpr void run_sorting_network(T* data) noexcept
+        {
+            constexpr auto& network = sorting_network<N>;
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                (compare_exchange(data, network[I].lo, network[I].hi), ...);
+            }(std::make_index_sequence<network.size()>{});
+        }
+
+        template <class Iter, class Compare>
+        constexpr void insertion_sort(Iter first, Iter last, Compare& comp)
+        {
+            if (first == last)
+            {
+                return;
+            }
+            for (auto it = first + 1; it != last; ++it)
+            {
+                auto value = std::move(*it);
+                auto hole = it;
+                for (; hole != first && std::invoke(comp, value, *(hole - 1)); --hole)
+                {
+                    *hole = std::move(*(hole - 1));
+                }
+                *hole = std::move(value);
+            }
+        }
+    }
+
+    // Sorts v, making use of the capacity being known at compile time:
+    // - Arithmetic elements with a capacity of at most 32, compared with less, are sorted by a branchless sorting
+    //   network generated for the capacity. The unused capacity is filled with +infinity (or the maximum value) so the
+    //   same network works for every size.
+    // - Other elements with a capacity of at most 32 are insertion sorted.
+    // - Everything else is handed to std::sort.
+    // Like std::sort, this isn't stable.
+    template <class T, std::size_t N, class Compare = ranges::less>
+    constexpr void sort(static_vector<T, N>& v, Compare comp = {})
+    {
+        if constexpr (N <= detail::max_network_size && detail::use_sorting_network<T, Compare>)
+        {
+            T* data = v.data();
+            for (std::size_t i = v.size(); i < N; ++i)
+            {
+                std::construct_at(data + i, detail::sort_sentinel<T>);
+            }
+            detail::run_sorting_network<N>(data);
+        }
+        else if constexpr (N <= detail::max_network_size)
+        {
+            detail::insertion_sort(v.begin(), v.end(), comp);
+        }
+        else
+        {
+            std::sort(v.begin(), v.end(), comp);
+        }
+    }
+
+}
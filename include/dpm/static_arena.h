@@ -0,0 +1,102 @@
+// Copyright (c) Daniel Marshall.
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+
+#include "static_vector.h"
+
+namespace dpm
+{
+    // A std::pmr::memory_resource that bump allocates out of Bytes of inline storage. Requests that don't fit are
+    // forwarded to the upstream resource, which by default is std::pmr::null_memory_resource() (i.e. they throw
+    // std::bad_alloc).
+    //
+    // Deallocation is a no-op unless it's the most recent inline allocation, in which case the space is reclaimed.
+    // release() reclaims all inline storage at once; allocations from upstream must be deallocated as usual.
+    template <std::size_t Bytes>
+    class static_arena : public std::pmr::memory_resource
+    {
+        static_assert(Bytes > 0, "static_arena must have some storage.");
+
+        uninitialized_storage<std::byte, Bytes> storage_;
+        std::size_t used_ = 0;
+        std::size_t peak_ = 0;
+        std::size_t fallback_hits_ = 0;
+        std::size_t fallback_bytes_ = 0;
+        std::pmr::memory_resource* upstream_;
+
+        [[nodiscard]] bool owns(const void* p) const noexcept
+        {
+            // Comparing unrelated pointers with < is unspecified, std::less gives a total order.
+            const std::less<const void*> less;
+            return !less(p, storage_.data()) && less(p, storage_.data() + Bytes);
+        }
+
+    public:
+        static_arena() noexcept : upstream_(std::pmr::null_memory_resource()) {}
+        explicit static_arena(std::pmr::memory_resource* upstream) noexcept : upstream_(upstream)
+        {
+            DPM_ASSERT(upstream != nullptr);
+        }
+        static_arena(const static_arena&) = delete;
+        static_arena& operator=(const static_arena&) = delete;
+
+        [[nodiscard]] std::pmr::memory_resource* upstream_resource() const noexcept { return upstream_; }
+
+        // Makes all of the inline storage available again; anything allocated from it must no longer be in use.
+        void release() noexcept { used_ = 0; }
+
+        [[nodiscard]] static constexpr std::size_t capacity() noexcept { return Bytes; }
+        [[nodiscard]] std::size_t bytes_used() const noexcept { return used_; }
+        [[nodiscard]] std::size_t bytes_remaining() const noexcept { return Bytes - used_; }
+        [[nodiscard]] std::size_t peak_bytes_used() const noexcept { return peak_; }
+        // Number of, and total bytes requested by, allocations that had to go to the upstream resource.
+        [[nodiscard]] std::size_t fallback_hits() const noexcept { return fallback_hits_; }
+        [[nodiscard]] std::size_t fallback_bytes() const noexcept { return fallback_bytes_; }
+
+    protected:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            const auto base = reinterpret_cast<std::uintptr_t>(storage_.data());
+            const auto aligned = (base + used_ + alignment - 1) & ~(alignment - 1);
+            const auto offset = static_cast<std::size_t>(aligned - base);
+            // offset must be inside the storage even for zero byte requests, as owns() doesn't include the end.
+            if (offset < Bytes && bytes <= Bytes - offset)
+            {
+                used_ = offset + bytes;
+                peak_ = std::max(peak_, used_);
+                return storage_.data() + offset;
+            }
+
+            auto* p = upstream_->allocate(bytes, alignment);
+            ++fallback_hits_;
+            fallback_bytes_ += bytes;
+            return p;
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+        {
+            if (!owns(p))
+            {
+                upstream_->deallocate(p, bytes, alignment);
+            }
+            else if (static_cast<std::byte*>(p) + bytes == storage_.data() + used_)
+            {
+                used_ = static_cast<std::size_t>(static_cast<std::byte*>(p) - storage_.data());
+            }
+        }
+
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+}
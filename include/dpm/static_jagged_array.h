@@ -0,0 +1,214 @@
+// Copyright (c) Daniel Marshall.
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "static_vector.h"
+
+namespace dpm
+{
+    // Up to MaxRows variable length rows with at most TotalCapacity elements between them. The rows are stored back to
+    // back in a single inline buffer, with a table of where each row starts.
+    template <class T, std::size_t TotalCapacity, std::size_t MaxRows>
+    class static_jagged_array
+    {
+        static_assert(!std::is_const_v<T>, "static_jagged_array can't contain const elements.");
+
+        using offset_type = smallest_size_type<TotalCapacity>;
+
+        uninitialized_storage<T, TotalCapacity> storage_;
+        // offsets_[r] is where row r starts and offsets_[rows_] is the total number of elements.
+        offset_type offsets_[MaxRows + 1] = {};
+        smallest_size_type<MaxRows> rows_ = 0;
+
+        constexpr static bool trivial_copy_ctor = std::is_trivially_copy_constructible_v<T>;
+        constexpr static bool trivial_move_ctor = std::is_trivially_move_constructible_v<T>;
+        constexpr static bool trivial_dtor = std::is_trivially_destructible_v<T>;
+        // Assigning may construct or destroy elements as the row layouts differ, so it can only be a plain copy of the
+        // storage if those are trivial too.
+        constexpr static bool trivial_copy_assignable =
+            std::is_trivially_copy_assignable_v<T> && trivial_copy_ctor && trivial_dtor;
+        constexpr static bool trivial_move_assignable =
+            std::is_trivially_move_assignable_v<T> && trivial_move_ctor && trivial_dtor;
+
+        [[nodiscard]] constexpr T* element_end() noexcept { return data() + size(); }
+
+        constexpr void copy_offsets(const static_jagged_array& other) noexcept
+        {
+            rows_ = other.rows_;
+            std::copy_n(other.offsets_, rows_ + 1, offsets_);
+        }
+
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using size_type = std::size_t;
+        using row_type = std::span<T>;
+        using const_row_type = std::span<const T>;
+
+        static_jagged_array() = default;
+        static_jagged_array(const static_jagged_array&) requires trivial_copy_ctor = default;
+        static_jagged_array(static_jagged_array&&) requires trivial_move_ctor = default;
+
+        constexpr static_jagged_array(const static_jagged_array& other)
+        {
+            static_assert(std::is_copy_constructible_v<value_type>, "value_type must be copy constructible.");
+            ranges::uninitialized_copy(other.elements(), std::span<T>(data(), other.size()));
+            copy_offsets(other);
+        }
+        constexpr static_jagged_array(static_jagged_array&& other) noexcept(
+            std::is_nothrow_move_constructible_v<value_type>)
+        {
+            static_assert(std::is_move_constructible_v<value_type>, "value_type must be move constructible.");
+            ranges::uninitialized_move(other.elements(), std::span<T>(data(), other.size()));
+            copy_offsets(other);
+            other.clear();
+        }
+
+        static_jagged_array& operator=(const static_jagged_array&) requires trivial_copy_assignable = default;
+        static_jagged_array& operator=(static_jagged_array&&) requires trivial_move_assignable = default;
+
+        constexpr static_jagged_array& operator=(const static_jagged_array& other)
+        {
+            if (this != std::addressof(other))
+            {
+                clear();
+                ranges::uninitialized_copy(other.elements(), std::span<T>(data(), other.size()));
+                copy_offsets(other);
+            }
+            return *this;
+        }
+        constexpr static_jagged_array& operator=(static_jagged_array&& other) noexcept(
+            std::is_nothrow_move_constructible_v<value_type>)
+        {
+            if (this != std::addressof(other))
+            {
+                clear();
+                ranges::uninitialized_move(other.elements(), std::span<T>(data(), other.size()));
+                copy_offsets(other);
+                other.clear();
+            }
+            return *this;
+        }
+
+        constexpr ~static_jagged_array() requires trivial_dtor = default;
+        constexpr ~static_jagged_array() { ranges::destroy(elements()); }
+
+        // size/capacity:
+        [[nodiscard]] constexpr bool empty() const noexcept { return rows_ == 0; }
+        [[nodiscard]] constexpr size_type rows() const noexcept { return rows_; }
+        [[nodiscard]] constexpr size_type size() const noexcept { return offsets_[rows_]; }
+        [[nodiscard]] static constexpr size_type max_rows() noexcept { return MaxRows; }
+        [[nodiscard]] static constexpr size_type capacity() noexcept { return TotalCapacity; }
+
+        // row and element access:
+        [[nodiscard]] constexpr row_type operator[](size_type row) noexcept
+        {
+            DPM_ASSERT(row < rows_);
+            return { data() + offsets_[row], data() + offsets_[row + 1] };
+        }
+        [[nodiscard]] constexpr const_row_type operator[](size_type row) const noexcept
+        {
+            DPM_ASSERT(row < rows_);
+            return { data() + offsets_[row], data() + offsets_[row + 1] };
+        }
+        [[nodiscard]] constexpr row_type front() noexcept { return (*this)[0]; }
+        [[nodiscard]] constexpr const_row_type front() const noexcept { return (*this)[0]; }
+        [[nodiscard]] constexpr row_type back() noexcept { return (*this)[rows_ - 1]; }
+        [[nodiscard]] constexpr const_row_type back() const noexcept { return (*this)[rows_ - 1]; }
+
+        // Every element of every row, in order.
+        [[nodiscard]] constexpr std::span<T> elements() noexcept { return { data(), size() }; }
+        [[nodiscard]] constexpr std::span<const T> elements() const noexcept { return { data(), size() }; }
+
+        [[nodiscard]] constexpr pointer data() noexcept { return std::launder(storage_.data()); }
+        [[nodiscard]] constexpr const_pointer data() const noexcept { return std::launder(storage_.data()); }
+
+        // modifiers:
+        constexpr row_type append_row() noexcept
+        {
+            DPM_ASSERT(rows_ < MaxRows);
+            offsets_[rows_ + 1] = offsets_[rows_];
+            ++rows_;
+            return back();
+        }
+        template <ranges::input_range Range>
+        constexpr row_type append_row(Range&& range)
+        {
+            static_assert(std::is_constructible_v<value_type, ranges::range_reference_t<Range>>,
+                "value_type must be constructible from the range's elements.");
+            DPM_ASSERT(rows_ < MaxRows);
+            const auto first = size();
+            if constexpr (ranges::sized_range<Range>)
+            {
+                DPM_ASSERT(ranges::size(range) <= capacity() - first);
+            }
+            auto [in, out] = ranges::uninitialized_copy(range, std::span<T>(data() + first, capacity() - first));
+            auto* last = std::to_address(out);
+            // uninitialized_copy stops when the storage is full, so anything left over means there wasn't room. The
+            // copies are destroyed first in case the contract violation handler throws.
+            if (in != ranges::end(range))
+            {
+                std::destroy(data() + first, last);
+                last = data() + first;
+                DPM_ASSERT(in == ranges::end(range));
+            }
+            offsets_[rows_ + 1] = static_cast<offset_type>(last - data());
+            ++rows_;
+            return back();
+        }
+        constexpr row_type append_row(std::initializer_list<value_type> il) { return append_row(std::span(il)); }
+
+        template <class... Args>
+        constexpr reference append_to_last_row(Args&&... args)
+        {
+            DPM_ASSERT(rows_ > 0);
+            DPM_ASSERT(size() < capacity());
+            auto* emplaced = std::construct_at(element_end(), std::forward<Args>(args)...);
+            ++offsets_[rows_];
+            return *emplaced;
+        }
+
+        constexpr void pop_row() noexcept
+        {
+            DPM_ASSERT(rows_ > 0);
+            ranges::destroy(back());
+            --rows_;
+        }
+
+        // Removes a row, moving the elements of the following rows down to fill the gap.
+        constexpr void erase_row(size_type row)
+        {
+            DPM_ASSERT(row < rows_);
+            const auto removed = static_cast<offset_type>(offsets_[row + 1] - offsets_[row]);
+            auto* old_end = element_end();
+            auto* new_end = std::move(data() + offsets_[row + 1], old_end, data() + offsets_[row]);
+            std::destroy(new_end, old_end);
+
+            for (size_type r = row + 1; r < rows_; ++r)
+            {
+                offsets_[r] = static_cast<offset_type>(offsets_[r + 1] - removed);
+            }
+            --rows_;
+        }
+
+        constexpr void clear() noexcept
+        {
+            ranges::destroy(elements());
+            rows_ = 0;
+        }
+    };
+
+}
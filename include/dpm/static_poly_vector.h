@@ -0,0 +1,294 @@
+// Copyright (c) Daniel Marshall.
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "static_vector.h"
+
+namespace dpm
+{
+    // A fixed capacity sequence of objects derived from Base, each stored inline in a slot of MaxSize bytes aligned to
+    // MaxAlign. Elements are accessed as Base&.
+    template <class Base, std::size_t Capacity, std::size_t MaxSize = sizeof(Base), std::size_t MaxAlign = alignof(Base)>
+    class static_poly_vector
+    {
+        static_assert(std::is_class_v<Base>, "static_poly_vector requires Base to be a class type.");
+        static_assert(!std::is_const_v<Base>, "static_poly_vector can't contain const elements.");
+        static_assert(MaxSize >= 1, "MaxSize must be at least 1.");
+        static_assert((MaxAlign & (MaxAlign - 1)) == 0, "MaxAlign must be a power of two.");
+
+        struct alignas(MaxAlign) slot
+        {
+            std::byte bytes[MaxSize];
+        };
+
+        // Type-erased operations for the most derived type stored in a slot.
+        struct element_ops
+        {
+            Base* (*move_construct)(std::byte* from, std::byte* to);
+            void (*destroy)(std::byte* at) noexcept;
+        };
+
+        template <class Derived>
+        static Base* move_construct_element(std::byte* from, std::byte* to)
+        {
+            return std::construct_at(
+                reinterpret_cast<Derived*>(to), std::move(*std::launder(reinterpret_cast<Derived*>(from))));
+        }
+        template <class Derived>
+        static void destroy_element(std::byte* at) noexcept
+        {
+            std::destroy_at(std::launder(reinterpret_cast<Derived*>(at)));
+        }
+        template <class Derived>
+        static constexpr element_ops ops_for{ &move_construct_element<Derived>, &destroy_element<Derived> };
+
+        struct record
+        {
+            Base* base;
+            const element_ops* ops;
+        };
+
+        uninitialized_storage<slot, Capacity> storage_;
+        record records_[Capacity];
+        smallest_size_type<Capacity> size_ = 0;
+
+        std::byte* slot_at(std::size_t i) noexcept { return storage_.storage + i * sizeof(slot); }
+
+        template <bool Const>
+        class basic_iterator
+        {
+            friend class static_poly_vector;
+            friend class basic_iterator<!Const>;
+            using record_pointer = std::conditional_t<Const, const record*, record*>;
+
+            record_pointer rec_ = nullptr;
+
+            constexpr explicit basic_iterator(record_pointer rec) noexcept : rec_(rec) {}
+
+        public:
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = Base;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, const Base*, Base*>;
+            using reference = std::conditional_t<Const, const Base&, Base&>;
+
+            basic_iterator() = default;
+            template <bool OtherConst>
+            requires(Const && !OtherConst) constexpr basic_iterator(const basic_iterator<OtherConst>& other) noexcept
+                : rec_(other.rec_)
+            {
+            }
+
+            [[nodiscard]] constexpr reference operator*() const noexcept { return *rec_->base; }
+            [[nodiscard]] constexpr pointer operator->() const noexcept { return rec_->base; }
+            [[nodiscard]] constexpr reference operator[](difference_type n) const noexcept { return *rec_[n].base; }
+
+            constexpr basic_iterator& operator++() noexcept
+            {
+                ++rec_;
+                return *this;
+            }
+            constexpr basic_iterator operator++(int) noexcept { return basic_iterator(rec_++); }
+            constexpr basic_iterator& operator--() noexcept
+            {
+                --rec_;
+                return *this;
+            }
+            constexpr basic_iterator operator--(int) noexcept { return basic_iterator(rec_--); }
+            constexpr basic_iterator& operator+=(difference_type n) noexcept
+            {
+                rec_ += n;
+                return *this;
+            }
+            constexpr basic_iterator& operator-=(difference_type n) noexcept
+            {
+                rec_ -= n;
+                return *this;
+            }
+
+            [[nodiscard]] friend constexpr basic_iterator operator+(basic_iterator it, difference_type n) noexcept
+            {
+                return it += n;
+            }
+            [[nodiscard]] friend constexpr basic_iterator operator+(difference_type n, basic_iterator it) noexcept
+            {
+                return it += n;
+            }
+            [[nodiscard]] friend constexpr basic_iterator operator-(basic_iterator it, difference_type n) noexcept
+            {
+                return it -= n;
+            }
+            [[nodiscard]] friend constexpr difference_type operator-(basic_iterator lhs, basic_iterator rhs) noexcept
+            {
+                return lhs.rec_ - rhs.rec_;
+            }
+
+            [[nodiscard]] constexpr bool operator==(const basic_iterator&) const noexcept = default;
+            [[nodiscard]] constexpr auto operator<=>(const basic_iterator&) const noexcept = default;
+        };
+
+    public:
+        using value_type = Base;
+        using pointer = Base*;
+        using const_pointer = const Base*;
+        using reference = Base&;
+        using const_reference = const Base&;
+        using size_type = smallest_size_type<Capacity>;
+        using difference_type = std::ptrdiff_t;
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        template <class Derived>
+        static constexpr bool fits = std::derived_from<Derived, Base> && sizeof(Derived) <= MaxSize &&
+                                     alignof(Derived) <= MaxAlign;
+
+        static_poly_vector() noexcept = default;
+        static_poly_vector(const static_poly_vector&) = delete;
+        static_poly_vector& operator=(const static_poly_vector&) = delete;
+
+        // Elements are moved with their own move constructors; other is left empty.
+        static_poly_vector(static_poly_vector&& other) { take(other); }
+        static_poly_vector& operator=(static_poly_vector&& other)
+        {
+            if (this != std::addressof(other))
+            {
+                clear();
+                take(other);
+            }
+            return *this;
+        }
+
+        ~static_poly_vector() { clear(); }
+
+        // iterators
+        [[nodiscard]] iterator begin() noexcept { return iterator(records_); }
+        [[nodiscard]] const_iterator begin() const noexcept { return const_iterator(records_); }
+        [[nodiscard]] iterator end() noexcept { return iterator(records_ + size_); }
+        [[nodiscard]] const_iterator end() const noexcept { return const_iterator(records_ + size_); }
+        [[nodiscard]] reverse_iterator rbegin() noexcept { return std::make_reverse_iterator(end()); }
+        [[nodiscard]] const_reverse_iterator rbegin() const noexcept { return std::make_reverse_iterator(end()); }
+        [[nodiscard]] reverse_iterator rend() noexcept { return std::make_reverse_iterator(begin()); }
+        [[nodiscard]] const_reverse_iterator rend() const noexcept { return std::make_reverse_iterator(begin()); }
+        [[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+        [[nodiscard]] const_iterator cend() const noexcept { return end(); }
+
+        // size/capacity:
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+        [[nodiscard]] size_type size() const noexcept { return size_; }
+        [[nodiscard]] static constexpr size_type max_size() noexcept { return Capacity; }
+        [[nodiscard]] static constexpr size_type capacity() noexcept { return Capacity; }
+        [[nodiscard]] static constexpr std::size_t slot_size() noexcept { return sizeof(slot); }
+
+        // element access:
+        [[nodiscard]] reference operator[](std::size_t n) noexcept
+        {
+            DPM_ASSERT(n < size_);
+            return *records_[n].base;
+        }
+        [[nodiscard]] const_reference operator[](std::size_t n) const noexcept
+        {
+            DPM_ASSERT(n < size_);
+            return *records_[n].base;
+        }
+        [[nodiscard]] reference front() { return *records_[0].base; }
+        [[nodiscard]] const_reference front() const { return *records_[0].base; }
+        [[nodiscard]] reference back() { return *records_[size_ - 1].base; }
+        [[nodiscard]] const_reference back() const { return *records_[size_ - 1].base; }
+
+        // modifiers:
+        template <class Derived, class... Args>
+        Derived& emplace_back(Args&&... args)
+        {
+            static_assert(std::derived_from<Derived, Base>, "Derived must publicly derive from Base.");
+            static_assert(!std::is_const_v<Derived>, "static_poly_vector can't contain const elements.");
+            static_assert(sizeof(Derived) <= MaxSize, "Derived is too large for the slot size (MaxSize).");
+            static_assert(alignof(Derived) <= MaxAlign, "Derived is over-aligned for the slot alignment (MaxAlign).");
+            static_assert(std::is_move_constructible_v<Derived>, "Derived must be move constructible.");
+            DPM_ASSERT(size_ < capacity());
+
+            auto* emplaced = std::construct_at(reinterpret_cast<Derived*>(slot_at(size_)), std::forward<Args>(args)...);
+            records_[size_] = { emplaced, &ops_for<Derived> };
+            ++size_;
+            return *emplaced;
+        }
+        template <class Derived>
+        void push_back(Derived&& x)
+        {
+            emplace_back<std::remove_cvref_t<Derived>>(std::forward<Derived>(x));
+        }
+
+        void pop_back() noexcept
+        {
+            DPM_ASSERT(!empty());
+            --size_;
+            records_[size_].ops->destroy(slot_at(size_));
+        }
+        iterator erase(const_iterator position)
+        {
+            const auto index = static_cast<std::size_t>(position.rec_ - records_);
+            DPM_ASSERT(index < size_);
+            records_[index].ops->destroy(slot_at(index));
+            for (auto i = index + 1; i < size_; ++i)
+            {
+                try
+                {
+                    records_[i - 1] = { records_[i].ops->move_construct(slot_at(i), slot_at(i - 1)), records_[i].ops };
+                }
+                catch (...)
+                {
+                    // Slot i - 1 is empty, so drop everything from it onwards to keep the elements contiguous.
+                    for (auto j = i; j < size_; ++j)
+                    {
+                        records_[j].ops->destroy(slot_at(j));
+                    }
+                    size_ = static_cast<size_type>(i - 1);
+                    throw;
+                }
+                records_[i].ops->destroy(slot_at(i));
+            }
+            --size_;
+            return iterator(records_ + index);
+        }
+        void clear() noexcept
+        {
+            while (!empty())
+            {
+                pop_back();
+            }
+        }
+
+    private:
+        void take(static_poly_vector& other)
+        {
+            try
+            {
+                for (; size_ < other.size_; ++size_)
+                {
+                    const auto* ops = other.records_[size_].ops;
+                    records_[size_] = { ops->move_construct(other.slot_at(size_), slot_at(size_)), ops };
+                }
+            }
+            catch (...)
+            {
+                clear();
+                throw;
+            }
+            other.clear();
+        }
+    };
+
+}
@@ -4,12 +4,62 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <compare>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <type_traits>
 #include <utility>
 
+// Precondition checks (bounds, capacity) are plain asserts by default. Defining DPM_HARDENED turns them into checks that
+// stay enabled in release builds, with the failure path moved out of line into the contract violation handler.
+#if defined(DPM_HARDENED)
+#define DPM_ASSERT(condition)                                                                                          \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(condition)) [[unlikely]]                                                                                 \
+        {                                                                                                              \
+            ::dpm::detail::contract_violation(#condition, __FILE__, __LINE__);                                         \
+        }                                                                                                              \
+    } while (false)
+#else
+#define DPM_ASSERT(condition) assert(condition)
+#endif
+
+// Under AddressSanitizer, hardened builds also mark static_vector's unused capacity as a container overflow region so
+// accesses past size() are reported. Define DPM_ANNOTATE_STATIC_VECTOR to 0 or 1 to override this.
+#if !defined(DPM_ANNOTATE_STATIC_VECTOR)
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer) && defined(DPM_HARDENED)
+#define DPM_ANNOTATE_STATIC_VECTOR 1
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__) && defined(DPM_HARDENED)
+#define DPM_ANNOTATE_STATIC_VECTOR 1
+#endif
+#endif
+#if !defined(DPM_ANNOTATE_STATIC_VECTOR)
+#define DPM_ANNOTATE_STATIC_VECTOR 0
+#endif
+#if DPM_ANNOTATE_STATIC_VECTOR
+#include <sanitizer/common_interface_defs.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DPM_COLD_NOINLINE [[gnu::cold, gnu::noinline]]
+#elif defined(_MSC_VER)
+#define DPM_COLD_NOINLINE __declspec(noinline)
+#else
+#define DPM_COLD_NOINLINE
+#endif
+
 namespace dpm
 {
     namespace
@@ -17,6 +67,35 @@ namespace dpm
         namespace ranges = std::ranges;
     }
 
+    // Called with the failed condition and its location when a hardened check fails. If the handler returns the
+    // program is aborted; it may throw, but not out of a noexcept function such as operator[].
+    using contract_violation_handler = void (*)(const char* condition, const char* file, int line);
+
+    namespace detail
+    {
+        inline std::atomic<contract_violation_handler> violation_handler = nullptr;
+
+        [[noreturn]] DPM_COLD_NOINLINE inline void contract_violation(const char* condition, const char* file, int line)
+        {
+            if (auto handler = violation_handler.load(std::memory_order_relaxed))
+            {
+                handler(condition, file, line);
+            }
+            else
+            {
+                std::fprintf(stderr, "%s:%d: dpm contract violation: %s\n", file, line, condition);
+            }
+            std::abort();
+        }
+    }
+
+    // Replaces the contract violation handler, returning the previous one. nullptr restores the default, which prints
+    // the failed condition and aborts.
+    inline contract_violation_handler set_contract_violation_handler(contract_violation_handler handler) noexcept
+    {
+        return detail::violation_handler.exchange(handler);
+    }
+
     template <std::size_t N>
     consteval auto determine_size_type() noexcept
     {
@@ -55,19 +134,80 @@ namespace dpm
         const T* data() const { return reinterpret_cast<const T*>(std::addressof(storage)); }
     };
 
+    namespace detail
+    {
+        // Gives algorithms that construct directly into the unused capacity access to the size.
+        struct static_vector_access;
+    }
+
     template <class T, std::size_t Capacity>
     class static_vector
     {
         static_assert(!std::is_const_v<T>, "static_vector can't contain const elements.");
+        friend struct detail::static_vector_access;
+        template <class, std::size_t>
+        friend class static_vector;
 
         uninitialized_storage<T, Capacity> storage_;
         smallest_size_type<Capacity> size_ = 0;
 
         constexpr static bool trivial_copy_ctor = std::is_trivially_copy_constructible_v<T>;
         constexpr static bool trivial_move_ctor = std::is_trivially_move_constructible_v<T>;
-        constexpr static bool trivial_copy_assignable = std::is_trivially_copy_assignable_v<T>;
-        constexpr static bool trivial_move_assignable = std::is_trivially_move_assignable_v<T>;
         constexpr static bool trivial_dtor = std::is_trivially_destructible_v<T>;
+        // Assignment can construct and destroy elements too, so it's only a plain copy if those are trivial as well.
+        constexpr static bool trivial_copy_assignable =
+            std::is_trivially_copy_assignable_v<T> && trivial_copy_ctor && trivial_dtor;
+        constexpr static bool trivial_move_assignable =
+            std::is_trivially_move_assignable_v<T> && trivial_move_ctor && trivial_dtor;
+        // Moving then destroying the source is equivalent to copying the bytes.
+        constexpr static bool trivially_relocatable = std::is_trivially_copyable_v<T>;
+        // relocate() ends each source element's lifetime as it goes, which can't be undone if a later move throws. Types
+        // whose move constructor can throw are moved then destroyed instead.
+        constexpr static bool nothrow_relocatable = std::is_nothrow_move_constructible_v<T>;
+
+        // Only vectors with no trivial special members are annotated, as trivial copies read the whole storage.
+        // Older sanitizer runtimes also need the storage to start on a shadow granule (8 bytes).
+        constexpr static bool annotate_storage = DPM_ANNOTATE_STATIC_VECTOR && !trivial_copy_ctor &&
+                                                 !trivial_move_ctor && !trivial_copy_assignable &&
+                                                 !trivial_move_assignable && !trivial_dtor && alignof(T) >= 8;
+
+        // Moves [first, last) to the uninitialized storage at out and ends the lifetime of the originals. The ranges may
+        // overlap if out is before first.
+        static T* relocate(T* first, T* last, T* out) noexcept
+        {
+            static_assert(nothrow_relocatable, "Only nothrow move constructible types can be relocated.");
+            const auto count = static_cast<std::size_t>(last - first);
+            if constexpr (trivially_relocatable)
+            {
+                if (count != 0)
+                {
+                    std::memmove(static_cast<void*>(out), first, count * sizeof(T));
+                }
+                return out + count;
+            }
+            else
+            {
+                for (; first != last; ++first, ++out)
+                {
+                    std::construct_at(out, std::move(*first));
+                    std::destroy_at(first);
+                }
+                return out;
+            }
+        }
+
+        // Marks [old_size, new_size) as accessible, or [new_size, old_size) as inaccessible.
+        void annotate([[maybe_unused]] std::size_t old_size, [[maybe_unused]] std::size_t new_size) const noexcept
+        {
+#if DPM_ANNOTATE_STATIC_VECTOR
+            if constexpr (annotate_storage)
+            {
+                const auto* first = storage_.data();
+                __sanitizer_annotate_contiguous_container(
+                    first, first + Capacity, first + old_size, first + new_size);
+            }
+#endif
+        }
 
     public:
         using value_type = T;
@@ -83,7 +223,8 @@ namespace dpm
         using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
         // 5.2, trivial copy/move construction:
-        static_vector() = default;
+        static_vector() requires(!annotate_storage) = default;
+        constexpr static_vector() noexcept requires annotate_storage { annotate(Capacity, 0); }
         static_vector(const static_vector& other) requires trivial_copy_ctor = default;
         static_vector(static_vector&& other) requires trivial_move_ctor = default;
 
@@ -92,24 +233,32 @@ namespace dpm
             : size_(other.size_)
         {
             static_assert(std::is_copy_constructible_v<value_type>, "value_type must be copy constructible.");
+            annotate(Capacity, size_);
             ranges::uninitialized_copy(other, *this);
         }
         constexpr static_vector(static_vector&& other) noexcept(std::is_nothrow_move_constructible_v<value_type>)
-            : size_(std::exchange(other.size_, 0))
+            : size_(other.size_)
         {
             static_assert(std::is_move_constructible_v<value_type>, "value_type must be move constructible.");
+            annotate(Capacity, size_);
             ranges::uninitialized_move_n(other.begin(), size_, begin(), end());
+            other.clear();
         }
-        constexpr explicit static_vector(size_type count) : size_(count)
+        // The counts taken by these constructors and by assign, resize and insert are std::size_t rather than size_type, so
+        // they're checked before being narrowed.
+        constexpr explicit static_vector(std::size_t count) : size_(static_cast<size_type>(count))
         {
             static_assert(std::is_default_constructible_v<value_type>, "value_type must be default constructible.");
-            assert(count <= capacity());
+            DPM_ASSERT(count <= capacity());
+            annotate(Capacity, size_);
             ranges::uninitialized_default_construct(*this);
         }
-        constexpr explicit static_vector(size_type count, const value_type& value) : size_(count)
+        constexpr explicit static_vector(std::size_t count, const value_type& value)
+            : size_(static_cast<size_type>(count))
         {
             static_assert(std::is_copy_constructible_v<value_type>, "value_type must be copy constructible.");
-            assert(count <= capacity());
+            DPM_ASSERT(count <= capacity());
+            annotate(Capacity, size_);
             ranges::uninitialized_fill(*this, value);
         }
         template <std::input_iterator InputIter>
@@ -117,16 +266,35 @@ namespace dpm
         {
             static_assert(std::is_constructible_v<value_type, decltype(*first)>,
                 "value_type must be constructible from decltype(*first)");
-            size_ = static_cast<size_type>(std::distance(first, last));
-            assert(size_ <= capacity());
+            const auto count = std::distance(first, last);
+            DPM_ASSERT(count >= 0 && static_cast<std::size_t>(count) <= capacity());
+            size_ = static_cast<size_type>(count);
+            annotate(Capacity, size_);
             ranges::uninitialized_copy(first, last, begin(), end());
         }
         constexpr static_vector(std::initializer_list<value_type> il) : size_(static_cast<size_type>(il.size()))
         {
-            assert(il.size() <= capacity());
+            DPM_ASSERT(il.size() <= capacity());
+            annotate(Capacity, size_);
             ranges::uninitialized_copy(il, *this);
         }
 
+        // Conversions from smaller capacities. Moving relocates the elements and leaves other empty.
+        template <std::size_t M>
+        requires(M < Capacity) constexpr static_vector(const static_vector<T, M>& other) : size_(other.size_)
+        {
+            static_assert(std::is_copy_constructible_v<value_type>, "value_type must be copy constructible.");
+            annotate(Capacity, size_);
+            ranges::uninitialized_copy(other, *this);
+        }
+        template <std::size_t M>
+        requires(M < Capacity) constexpr static_vector(static_vector<T, M>&& other)
+        {
+            static_assert(std::is_move_constructible_v<value_type>, "value_type must be move constructible.");
+            annotate(Capacity, 0);
+            move_append(other);
+        }
+
         // 5.3, copy/move assignment:
         static_vector& operator=(const static_vector& other) requires trivial_copy_assignable = default;
         static_vector& operator=(static_vector&& other) requires trivial_move_assignable = default;
@@ -143,37 +311,73 @@ namespace dpm
             auto amount = std::min(size_, other.size_);
             auto [move_end, this_begin] = ranges::copy_n(std::make_move_iterator(other.begin()), amount, begin());
             ranges::destroy(this_begin, end());
+            annotate(size_, amount);
+            annotate(amount, other.size_);
 
             size_ = other.size_;
             ranges::uninitialized_move(move_end, std::make_move_iterator(other.end()), this_begin, end());
-            ranges::destroy(other);
-            other.size_ = 0;
+            other.clear();
+            return *this;
+        }
+        template <std::size_t M>
+        requires(M < Capacity) constexpr static_vector& operator=(const static_vector<T, M>& other)
+        {
+            assign(other.begin(), other.end());
+            return *this;
+        }
+        template <std::size_t M>
+        requires(M < Capacity) constexpr static_vector& operator=(static_vector<T, M>&& other)
+        {
+            clear();
+            move_append(other);
             return *this;
         }
         template <std::input_iterator InputIterator>
         constexpr void assign(InputIterator first, InputIterator last)
         {
-            auto new_size = std::distance(first, last);
-            auto min = std::min<ptrdiff_t>(size_, new_size);
+            const auto new_size = std::distance(first, last);
+            DPM_ASSERT(new_size >= 0 && static_cast<std::size_t>(new_size) <= capacity());
+            const auto min = std::min<ptrdiff_t>(size_, new_size);
 
             auto [in, out] = ranges::copy_n(first, min, begin());
-            auto [_, new_end] = ranges::uninitialized_copy(in, last, out, end());
-            ranges::destroy(new_end, end());
+            if (new_size > size_)
+            {
+                annotate(size_, static_cast<std::size_t>(new_size));
+                ranges::uninitialized_copy(in, last, out, std::unreachable_sentinel);
+            }
+            else
+            {
+                ranges::destroy(out, end());
+                annotate(size_, static_cast<std::size_t>(new_size));
+            }
             size_ = static_cast<size_type>(new_size);
         }
-        constexpr void assign(size_type n, const value_type& value)
+        constexpr void assign(std::size_t n, const value_type& value)
         {
-            auto min = std::min(size_, n);
+            DPM_ASSERT(n <= capacity());
+            auto min = std::min<std::size_t>(size_, n);
             auto fill_end = ranges::fill_n(begin(), min, value);
-            auto new_end = ranges::uninitialized_fill_n(fill_end, n - min, value);
-            size_ = n;
-            ranges::destroy(new_end, end());
+            if (n > size_)
+            {
+                annotate(size_, n);
+                ranges::uninitialized_fill_n(fill_end, n - min, value);
+            }
+            else
+            {
+                ranges::destroy(fill_end, end());
+                annotate(size_, n);
+            }
+            size_ = static_cast<size_type>(n);
         }
         constexpr void assign(std::initializer_list<value_type> il) { assign(il.begin(), il.end()); }
 
         // 5.4, destruction
         constexpr ~static_vector() noexcept requires trivial_dtor = default;
-        constexpr ~static_vector() { ranges::destroy_n(begin(), size_); }
+        constexpr ~static_vector()
+        {
+            ranges::destroy_n(begin(), size_);
+            annotate(size_, Capacity);
+        }
 
         // iterators
         [[nodiscard]] constexpr iterator begin() noexcept { return data(); }
@@ -195,47 +399,51 @@ namespace dpm
         [[nodiscard]] static constexpr size_type max_size() noexcept { return Capacity; }
         [[nodiscard]] static constexpr size_type capacity() noexcept { return Capacity; }
 
-        constexpr void resize(size_type sz)
+        constexpr void resize(std::size_t sz)
         {
             static_assert(std::is_default_constructible_v<value_type>, "T must be default constuctible");
-            assert(sz <= capacity());
+            DPM_ASSERT(sz <= capacity());
             if (sz < size_)
             {
                 const auto amount = size_ - sz;
                 ranges::destroy_n(data() + sz, amount);
+                annotate(size_, sz);
             }
             else
             {
                 const auto amount = sz - size_;
+                annotate(size_, sz);
                 ranges::uninitialized_default_construct_n(end(), amount);
             }
-            size_ = sz;
+            size_ = static_cast<size_type>(sz);
         }
-        constexpr void resize(size_type sz, const value_type& value)
+        constexpr void resize(std::size_t sz, const value_type& value)
         {
-            assert(sz <= capacity());
+            DPM_ASSERT(sz <= capacity());
             if (sz < size_)
             {
                 const auto amount = size_ - sz;
                 ranges::destroy_n(data() + sz, amount);
+                annotate(size_, sz);
             }
             else
             {
                 const auto amount = sz - size_;
+                annotate(size_, sz);
                 ranges::uninitialized_fill_n(end(), amount, value);
             }
-            size_ = sz;
+            size_ = static_cast<size_type>(sz);
         }
 
         // 5.6, element and data access:
         [[nodiscard]] constexpr reference operator[](size_t n) noexcept
         {
-            assert(n < size_ && n >= 0);
+            DPM_ASSERT(n < size_);
             return data()[n];
         }
         [[nodiscard]] constexpr const_reference operator[](size_t n) const noexcept
         {
-            assert(n < size_ && n >= 0);
+            DPM_ASSERT(n < size_);
             return data()[n];
         }
 
@@ -251,19 +459,19 @@ namespace dpm
         // 5.7, modifiers:
         constexpr iterator insert(const_iterator position, const value_type& x)
         {
-            assert(size_ < capacity());
+            DPM_ASSERT(size_ < capacity());
             emplace_back(x);
             return ranges::rotate(const_cast<iterator>(position), end() - 1, end()).begin() - 1;
         }
         constexpr iterator insert(const_iterator position, value_type&& x)
         {
-            assert(size_ < capacity());
+            DPM_ASSERT(size_ < capacity());
             emplace_back(std::move(x));
             return ranges::rotate(const_cast<iterator>(position), end() - 1, end()).begin() - 1;
         }
-        constexpr iterator insert(const_iterator position, size_type n, const value_type& x)
+        constexpr iterator insert(const_iterator position, std::size_t n, const value_type& x)
         {
-            assert(size_ + n <= capacity());
+            DPM_ASSERT(n <= static_cast<std::size_t>(capacity() - size_));
             auto old_end = end();
             for (size_t i = 0; i < n; ++i)
             {
@@ -277,9 +485,19 @@ namespace dpm
         constexpr iterator insert(const_iterator position, InputIterator first, InputIterator last)
         {
             auto old_end = end();
-            size_ += static_cast<size_type>(std::distance(first, last));
-            assert(size_ <= capacity());
-            ranges::uninitialized_copy(first, last, old_end, end());
+            const auto count = std::distance(first, last);
+            DPM_ASSERT(count >= 0 && size_ + static_cast<std::size_t>(count) <= capacity());
+            annotate(size_, size_ + static_cast<std::size_t>(count));
+            try
+            {
+                ranges::uninitialized_copy(first, last, old_end, old_end + count);
+            }
+            catch (...)
+            {
+                annotate(size_ + static_cast<std::size_t>(count), size_);
+                throw;
+            }
+            size_ += static_cast<size_type>(count);
 
             auto pos = const_cast<iterator>(position);
             ranges::rotate(pos, old_end, end());
@@ -293,7 +511,7 @@ namespace dpm
         template <class... Args>
         constexpr iterator emplace(const_iterator position, Args&&... args)
         {
-            assert(size_ < capacity());
+            DPM_ASSERT(size_ < capacity());
             emplace_back(std::forward<Args>(args)...);
             return ranges::rotate(iterator(position), end() - 1, end()).begin() - 1;
         }
@@ -301,7 +519,8 @@ namespace dpm
         template <class... Args>
         constexpr reference emplace_back(Args&&... args)
         {
-            assert(size_ < capacity());
+            DPM_ASSERT(size_ < capacity());
+            annotate(size_, size_ + 1);
             auto* emplaced = std::construct_at(end(), std::forward<Args>(args)...);
             ++size_;
             return *emplaced;
@@ -311,8 +530,10 @@ namespace dpm
 
         constexpr void pop_back()
         {
+            DPM_ASSERT(!empty());
             std::destroy_at(std::addressof(back()));
             --size_;
+            annotate(size_ + 1, size_);
         }
         constexpr iterator erase(const_iterator position)
         {
@@ -320,41 +541,121 @@ namespace dpm
             auto pos = const_cast<iterator>(position);
             ranges::rotate(pos, pos + 1, end());
             --size_;
+            annotate(size_ + 1, size_);
             return pos;
         }
         constexpr iterator erase(const_iterator first, const_iterator last)
         {
             auto removed_end = const_cast<iterator>(ranges::destroy(first, last));
             ranges::rotate(const_cast<iterator>(first), removed_end, end());
+            const auto old_size = size_;
             size_ -= static_cast<size_type>(std::distance(first, last));
+            annotate(old_size, size_);
             return removed_end;
         }
 
         constexpr void clear() noexcept
         {
             ranges::destroy(*this);
+            annotate(size_, 0);
             size_ = 0;
         }
 
+        // Moves [first, last) out of other to before position, closing the gap left in other. Elements are relocated
+        // (memmove for trivially copyable types) rather than copied, unless value_type's move constructor can throw.
+        // Returns an iterator to the first moved element.
+        template <std::size_t M>
+        constexpr iterator splice(
+            const_iterator position, static_vector<T, M>& other, const_iterator first, const_iterator last)
+        {
+            if constexpr (M == Capacity)
+            {
+                DPM_ASSERT(this != &other);
+            }
+            const auto count = static_cast<std::size_t>(last - first);
+            DPM_ASSERT(size_ + count <= capacity());
+            auto pos = const_cast<iterator>(position);
+            auto from = const_cast<iterator>(first);
+            auto from_end = const_cast<iterator>(last);
+            const auto other_size = other.size_;
+
+            if constexpr (trivially_relocatable)
+            {
+                annotate(size_, size_ + count);
+                std::memmove(static_cast<void*>(pos + count), pos, static_cast<std::size_t>(end() - pos) * sizeof(T));
+                relocate(from, from_end, pos);
+                size_ += static_cast<size_type>(count);
+                relocate(from_end, other.end(), from);
+            }
+            else if constexpr (nothrow_relocatable)
+            {
+                annotate(size_, size_ + count);
+                auto old_end = end();
+                relocate(from, from_end, old_end);
+                size_ += static_cast<size_type>(count);
+                ranges::rotate(pos, old_end, end());
+                relocate(from_end, other.end(), from);
+            }
+            else
+            {
+                pos = insert(position, std::make_move_iterator(from), std::make_move_iterator(from_end));
+                auto other_end = std::move(from_end, other.end(), from);
+                ranges::destroy(other_end, other.end());
+            }
+            other.size_ = static_cast<typename static_vector<T, M>::size_type>(other_size - count);
+            other.annotate(other_size, other.size_);
+            return pos;
+        }
+        template <std::size_t M>
+        constexpr iterator splice(const_iterator position, static_vector<T, M>& other)
+        {
+            return splice(position, other, other.begin(), other.end());
+        }
+        // Moves every element of other onto the end, leaving other empty.
+        template <std::size_t M>
+        constexpr void move_append(static_vector<T, M>& other)
+        {
+            splice(end(), other, other.begin(), other.end());
+        }
+
+        // Moves [position, end()) into a new vector with capacity M, which defaults to this vector's capacity.
+        template <std::size_t M = Capacity>
+        [[nodiscard]] constexpr static_vector<T, M> split_at(const_iterator position)
+        {
+            const auto count = static_cast<std::size_t>(end() - position);
+            DPM_ASSERT(count <= M);
+            auto pos = const_cast<iterator>(position);
+            static_vector<T, M> tail;
+            if constexpr (nothrow_relocatable)
+            {
+                tail.annotate(0, count);
+                relocate(pos, end(), tail.data());
+                tail.size_ = static_cast<typename static_vector<T, M>::size_type>(count);
+            }
+            else
+            {
+                tail.insert(tail.end(), std::make_move_iterator(pos), std::make_move_iterator(end()));
+                ranges::destroy(pos, end());
+            }
+
+            const auto old_size = size_;
+            size_ = static_cast<size_type>(position - begin());
+            annotate(old_size, size_);
+            return tail;
+        }
+
         constexpr void swap(static_vector& other) noexcept(
             std::is_nothrow_swappable_v<value_type>&& std::is_nothrow_move_constructible_v<value_type>) requires
             std::is_move_constructible_v<value_type> && std::is_swappable_v<value_type>
         {
-            // Could this be simpler?
-            auto [smaller_begin, smaller_end, larger_begin, larger_end] = [&] {
-                if (size_ < other.size_)
-                {
-                    return std::array<iterator, 4>{ begin(), end(), other.begin(), other.end() };
-                }
-                return std::array<iterator, 4>{ other.begin(), other.end(), begin(), end() };
-            }();
+            auto& smaller = size_ < other.size_ ? *this : other;
+            auto& larger = size_ < other.size_ ? other : *this;
 
-            for (; smaller_begin != smaller_end; ++smaller_begin, ++larger_begin)
-            {
-                ranges::iter_swap(smaller_begin, larger_begin);
-            }
-            ranges::uninitialized_move(larger_begin, larger_end, smaller_begin, std::unreachable_sentinel);
-            ranges::destroy(larger_begin, larger_end);
+            auto [smaller_end, larger_mid] = ranges::swap_ranges(smaller, larger);
+            smaller.annotate(smaller.size_, larger.size_);
+            ranges::uninitialized_move(larger_mid, larger.end(), smaller_end, std::unreachable_sentinel);
+            ranges::destroy(larger_mid, larger.end());
+            larger.annotate(larger.size_, smaller.size_);
             std::swap(size_, other.size_);
         }
 
@@ -375,4 +676,20 @@ namespace dpm
         x.swap(y);
     }
 
+    // The elements of x followed by those of y, in a vector with room for both.
+    template <typename T, size_t N, size_t M>
+    [[nodiscard]] constexpr static_vector<T, N + M> concat(const static_vector<T, N>& x, const static_vector<T, M>& y)
+    {
+        static_vector<T, N + M> result(x);
+        result.insert(result.end(), y.begin(), y.end());
+        return result;
+    }
+    template <typename T, size_t N, size_t M>
+    [[nodiscard]] constexpr static_vector<T, N + M> concat(static_vector<T, N>&& x, static_vector<T, M>&& y)
+    {
+        static_vector<T, N + M> result(std::move(x));
+        result.move_append(y);
+        return result;
+    }
+
 }
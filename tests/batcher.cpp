@@ -0,0 +1,195 @@
+// Copyright (c) Daniel Marshall.
+// SPDX-License-Identifier: BSL-1.0
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <doctest/doctest.h>
+#include <dpm/batcher.h>
+
+using namespace dpm;
+
+namespace
+{
+    // A clock that only moves when told to, so deadlines can be tested without sleeping.
+    struct manual_clock
+    {
+        using rep = std::int64_t;
+        using period = std::milli;
+        using duration = std::chrono::duration<rep, period>;
+        using time_point = std::chrono::time_point<manual_clock>;
+        static constexpr bool is_steady = true;
+
+        static inline std::atomic<rep> ticks = 0;
+        static time_point now() noexcept { return time_point(duration(ticks.load())); }
+        static void advance(duration d) noexcept { ticks += d.count(); }
+    };
+
+    // Records every batch it's given.
+    struct recording_sink
+    {
+        std::mutex* mutex;
+        std::vector<std::vector<int>>* batches;
+
+        template <std::size_t N>
+        void operator()(static_vector<int, N>& batch) const
+        {
+            std::lock_guard lock(*mutex);
+            batches->emplace_back(batch.begin(), batch.end());
+        }
+    };
+}
+
+TEST_CASE("batcher")
+{
+    std::mutex mutex;
+    std::vector<std::vector<int>> batches;
+    recording_sink sink{ &mutex, &batches };
+
+    SUBCASE("flushes when full")
+    {
+        {
+            batcher<int, 4, recording_sink> b(sink);
+            CHECK(b.batch_capacity() == 4);
+            for (int i = 0; i < 10; ++i)
+            {
+                b.push(i);
+            }
+            CHECK(b.pending_items() == 2);
+            b.wait();
+            CHECK(batches.size() == 2);
+
+            const auto stats = b.stats();
+            CHECK(stats.batches == 2);
+            CHECK(stats.items == 8);
+            CHECK(stats.full_flushes == 2);
+            CHECK(stats.min_batch_size == 4);
+            CHECK(stats.max_batch_size == 4);
+            CHECK(stats.mean_batch_size() == 4.0);
+        }
+        // The destructor sends what was left.
+        REQUIRE(batches.size() == 3);
+        CHECK(batches[0] == std::vector{ 0, 1, 2, 3 });
+        CHECK(batches[1] == std::vector{ 4, 5, 6, 7 });
+        CHECK(batches[2] == std::vector{ 8, 9 });
+    }
+
+    SUBCASE("flush")
+    {
+        batcher<int, 8, recording_sink> b(sink);
+        b.flush();
+        b.push(1);
+        b.emplace(2);
+        b.flush();
+        b.wait();
+        CHECK(b.pending_items() == 0);
+        REQUIRE(batches.size() == 1);
+        CHECK(batches[0] == std::vector{ 1, 2 });
+
+        const auto stats = b.stats();
+        CHECK(stats.batches == 1);
+        CHECK(stats.manual_flushes == 1);
+        CHECK(stats.total_flush_latency >= stats.last_flush_latency);
+        CHECK(stats.max_flush_latency == stats.last_flush_latency);
+    }
+
+    SUBCASE("deadline")
+    {
+        using namespace std::chrono_literals;
+        batcher<int, 8, recording_sink, manual_clock> b(sink, manual_clock::duration(10ms));
+        CHECK(b.max_delay() == 10ms);
+
+        b.push(1);
+        manual_clock::advance(5ms);
+        b.push(2);
+        CHECK(b.pending_items() == 2);
+        manual_clock::advance(5ms);
+        // The deadline is only checked as items are added.
+        CHECK(b.pending_items() == 2);
+        b.push(3);
+        CHECK(b.pending_items() == 0);
+
+        // The next batch's deadline starts from its first item.
+        manual_clock::advance(100ms);
+        b.push(4);
+        CHECK(b.pending_items() == 1);
+        b.wait();
+
+        REQUIRE(batches.size() == 1);
+        CHECK(batches[0] == std::vector{ 1, 2, 3 });
+        const auto stats = b.stats();
+        CHECK(stats.deadline_flushes == 1);
+        CHECK(stats.full_flushes == 0);
+    }
+
+    SUBCASE("overlaps filling with the sink")
+    {
+        std::atomic<bool> release = false;
+        std::atomic<int> seen = 0;
+        auto slow_sink = [&](static_vector<int, 4>& batch) {
+            while (!release)
+            {
+                std::this_thread::yield();
+            }
+            seen += static_cast<int>(batch.size());
+        };
+
+        batcher<int, 4, decltype(slow_sink)> b(slow_sink);
+        for (int i = 0; i < 4; ++i)
+        {
+            b.push(i);
+        }
+        // The first batch is stuck in the sink, but the second can still fill.
+        for (int i = 0; i < 3; ++i)
+        {
+            b.push(i);
+        }
+        CHECK(b.pending_items() == 3);
+        release = true;
+        b.push(3);
+        b.wait();
+        CHECK(seen == 8);
+        CHECK(b.stats().batches == 2);
+    }
+
+    SUBCASE("sink exceptions")
+    {
+        auto throwing_sink = [](static_vector<int, 2>& batch) {
+            if (batch[0] == 0)
+            {
+                throw std::runtime_error("sink");
+            }
+        };
+
+        batcher<int, 2, decltype(throwing_sink)> b(throwing_sink);
+        b.push(0);
+        b.push(1);
+        CHECK_THROWS_AS(b.wait(), std::runtime_error);
+        // Reported once, and the batcher carries on.
+        CHECK_NOTHROW(b.wait());
+        b.push(2);
+        b.push(3);
+        CHECK_NOTHROW(b.wait());
+        CHECK(b.stats().batches == 2);
+    }
+
+    SUBCASE("many batches")
+    {
+        std::atomic<long long> sum = 0;
+        auto summing_sink = [&](static_vector<int, 64>& batch) {
+            sum += std::accumulate(batch.begin(), batch.end(), 0LL);
+        };
+        {
+            batcher<int, 64, decltype(summing_sink)> b(summing_sink);
+            for (int i = 0; i < 100'000; ++i)
+            {
+                b.push(i);
+            }
+        }
+        CHECK(sum == 100'000LL * 99'999 / 2);
+    }
+}
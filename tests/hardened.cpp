@@ -0,0 +1,244 @@
+// Copyright (c) Daniel Marshall.
+// SPDX-License-Identifier: BSL-1.0
+
+// Built with DPM_HARDENED defined, into sv_hardened_test and, where AddressSanitizer is available, sv_asan_test.
+
+#include <array>
+#include <cstdlib>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+
+#include <doctest/doctest.h>
+#include <dpm/static_jagged_array.h>
+#include <dpm/static_vector.h>
+
+#if __has_include(<sys/wait.h>)
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#define DPM_TEST_FORK 1
+#endif
+
+#if !defined(DPM_HARDENED)
+#error "hardened.cpp must be built with DPM_HARDENED defined."
+#endif
+
+using namespace dpm;
+
+namespace
+{
+    struct violation : std::logic_error
+    {
+        using std::logic_error::logic_error;
+    };
+
+    void throwing_handler(const char* condition, const char*, int) { throw violation(condition); }
+
+    struct counter
+    {
+        inline static int count = 0;
+        int value = 0;
+        counter(int v = 0) noexcept : value(v) { ++count; }
+        counter(const counter& other) noexcept : value(other.value) { ++count; }
+        counter& operator=(const counter&) noexcept = default;
+        ~counter() { --count; }
+    };
+
+    struct scoped_handler
+    {
+        contract_violation_handler previous = set_contract_violation_handler(throwing_handler);
+        ~scoped_handler() { set_contract_violation_handler(previous); }
+    };
+
+    template <class Fn>
+    bool violates(Fn fn)
+    {
+        try
+        {
+            fn();
+        }
+        catch (const violation&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+#if defined(DPM_TEST_FORK)
+    // operator[] is noexcept, so a violation there can't be caught. Runs fn in a child process and returns its wait
+    // status instead.
+    template <class Fn>
+    int status_of_child(Fn fn)
+    {
+        const pid_t pid = ::fork();
+        if (pid == 0)
+        {
+            fn();
+            std::_Exit(0);
+        }
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        return status;
+    }
+
+    constexpr int violation_exit_code = 42;
+    void exiting_handler(const char*, const char*, int) { std::_Exit(violation_exit_code); }
+#endif
+}
+
+TEST_CASE("hardened checks")
+{
+    scoped_handler handler;
+
+    SUBCASE("set_contract_violation_handler")
+    {
+        CHECK(handler.previous == nullptr);
+        CHECK(set_contract_violation_handler(throwing_handler) == throwing_handler);
+    }
+    SUBCASE("emplace_back")
+    {
+        static_vector<int, 2> sv{ 1, 2 };
+        CHECK(violates([&] { sv.emplace_back(3); }));
+        CHECK(violates([&] { sv.push_back(3); }));
+        CHECK(sv.size() == 2);
+    }
+    SUBCASE("insert")
+    {
+        static_vector<std::string, 3> sv{ "a", "b" };
+        CHECK(violates([&] { sv.insert(sv.begin(), 2, "c"); }));
+        CHECK(violates([&] { sv.insert(sv.begin(), { "c", "d" }); }));
+        const std::array<std::string, 2> more{ "c", "d" };
+        CHECK(violates([&] { sv.insert(sv.end(), more.begin(), more.end()); }));
+        // The capacity is checked before anything changes.
+        CHECK(sv.size() == 2);
+        CHECK(!violates([&] { sv.insert(sv.begin(), "c"); }));
+        CHECK(violates([&] { sv.insert(sv.begin(), "d"); }));
+        CHECK(sv.size() == 3);
+    }
+    SUBCASE("resize/assign")
+    {
+        static_vector<std::string, 3> sv;
+        CHECK(violates([&] { sv.resize(4); }));
+        CHECK(violates([&] { sv.resize(4, "a"); }));
+        CHECK(violates([&] { sv.assign(4, "a"); }));
+        CHECK(sv.empty());
+    }
+    SUBCASE("counts that don't fit in size_type")
+    {
+        // size_type is a single byte here, so 256 and 259 would narrow to 0 and 3, which do fit.
+        static_vector<std::string, 3> sv;
+        CHECK(violates([&] { sv.resize(std::size_t{ 259 }); }));
+        CHECK(violates([&] { sv.resize(std::size_t{ 256 }, "a"); }));
+        CHECK(violates([&] { sv.assign(std::size_t{ 259 }, "a"); }));
+        CHECK(violates([&] { sv.insert(sv.begin(), std::size_t{ 259 }, "a"); }));
+        CHECK(sv.empty());
+        CHECK(violates([] { static_vector<std::string, 3> v(std::size_t{ 256 }); }));
+        CHECK(violates([] { static_vector<std::string, 3> v(std::size_t{ 259 }, "a"); }));
+    }
+    SUBCASE("construction")
+    {
+        CHECK(violates([] { static_vector<int, 2> sv(3); }));
+        CHECK(violates([] { static_vector<int, 2> sv{ 1, 2, 3 }; }));
+        const std::array<std::string, 3> values{ "a", "b", "c" };
+        CHECK(violates([&] { static_vector<std::string, 2> sv(values.begin(), values.end()); }));
+    }
+    SUBCASE("pop_back")
+    {
+        static_vector<int, 2> sv;
+        CHECK(violates([&] { sv.pop_back(); }));
+    }
+    SUBCASE("static_jagged_array append_row")
+    {
+        {
+            static_jagged_array<counter, 4, 4> ja;
+            ja.append_row({ counter(1) });
+            // filter isn't sized, so the overflow is only found once the storage has been filled.
+            const std::array<counter, 4> values{ 2, 3, 4, 5 };
+            auto unsized = values | std::views::filter([](const counter&) { return true; });
+            CHECK(violates([&] { ja.append_row(unsized); }));
+            CHECK(ja.rows() == 1);
+            CHECK(ja.size() == 1);
+            CHECK(counter::count == 5);
+        }
+        CHECK(counter::count == 0);
+    }
+}
+
+#if defined(DPM_TEST_FORK)
+TEST_CASE("hardened operator[]")
+{
+    static_vector<int, 4> sv{ 1, 2 };
+    const auto& csv = sv;
+
+    auto status = status_of_child([&] {
+        set_contract_violation_handler(exiting_handler);
+        volatile int x = sv[1];
+        (void)x;
+    });
+    CHECK((WIFEXITED(status) && WEXITSTATUS(status) == 0));
+
+    status = status_of_child([&] {
+        set_contract_violation_handler(exiting_handler);
+        volatile int x = sv[2];
+        (void)x;
+    });
+    CHECK((WIFEXITED(status) && WEXITSTATUS(status) == violation_exit_code));
+
+    status = status_of_child([&] {
+        set_contract_violation_handler(exiting_handler);
+        volatile int x = csv[3];
+        (void)x;
+    });
+    CHECK((WIFEXITED(status) && WEXITSTATUS(status) == violation_exit_code));
+
+    // Without a handler the default reports the violation and aborts.
+    status = status_of_child([&] {
+        set_contract_violation_handler(nullptr);
+        volatile int x = sv[2];
+        (void)x;
+    });
+    CHECK((WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT));
+}
+#endif
+
+#if DPM_ANNOTATE_STATIC_VECTOR
+// Only built under AddressSanitizer. Checks that exactly [data(), data() + size()) of the storage is accessible.
+TEST_CASE("container overflow annotations")
+{
+    auto annotated_correctly = [](const auto& sv) {
+        const void* first = sv.data();
+        return __sanitizer_verify_contiguous_container(first, sv.data() + sv.size(), sv.data() + sv.capacity()) != 0;
+    };
+
+    static_vector<std::string, 4> sv;
+    CHECK(annotated_correctly(sv));
+    sv.push_back("a");
+    sv.emplace_back("b");
+    CHECK(annotated_correctly(sv));
+    sv.insert(sv.begin(), { "c" });
+    CHECK(annotated_correctly(sv));
+    sv.pop_back();
+    CHECK(annotated_correctly(sv));
+    sv.resize(4);
+    CHECK(annotated_correctly(sv));
+    sv.erase(sv.begin(), sv.begin() + 2);
+    CHECK(annotated_correctly(sv));
+
+    static_vector<std::string, 8> other{ "x", "y", "z" };
+    sv.splice(sv.begin(), other, other.begin(), other.begin() + 1);
+    CHECK(annotated_correctly(sv));
+    CHECK(annotated_correctly(other));
+    auto tail = other.split_at(other.begin() + 1);
+    CHECK(annotated_correctly(other));
+    CHECK(annotated_correctly(tail));
+
+    static_vector<std::string, 4> copy = sv;
+    CHECK(annotated_correctly(copy));
+    sv.clear();
+    CHECK(annotated_correctly(sv));
+    sv.swap(copy);
+    CHECK(annotated_correctly(sv));
+    CHECK(annotated_correctly(copy));
+}
+#endif
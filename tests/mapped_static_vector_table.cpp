@@ -0,0 +1,126 @@
+// Copyright (c) Daniel Marshall.
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <doctest/doctest.h>
+#include <dpm/mapped_static_vector_table.h>
+
+#ifdef DPM_HAS_MAPPED_STATIC_VECTOR_TABLE
+
+using namespace dpm;
+
+namespace
+{
+    struct temp_file
+    {
+        std::filesystem::path path;
+        explicit temp_file(const char* name) : path(std::filesystem::temp_directory_path() / name)
+        {
+            std::filesystem::remove(path);
+        }
+        ~temp_file() { std::filesystem::remove(path); }
+    };
+}
+
+TEST_CASE("mapped_static_vector_table")
+{
+    SUBCASE("create/open")
+    {
+        temp_file file("dpm_mapped_table_test.bin");
+        {
+            auto table = mapped_static_vector_table<int, 4>::create(file.path, 3);
+            CHECK(table.is_open());
+            CHECK(table.size() == 3);
+            for (const auto& record : table)
+            {
+                CHECK(record.empty());
+            }
+            table[0].push_back(1);
+            table[0].push_back(2);
+            table[2] = { 7, 8, 9, 10 };
+            table.flush();
+        }
+        {
+            auto table = mapped_static_vector_table<int, 4>::open(file.path);
+            CHECK(table.size() == 3);
+            CHECK(table[0] == static_vector<int, 4>{ 1, 2 });
+            CHECK(table[1].empty());
+            CHECK(table[2] == static_vector<int, 4>{ 7, 8, 9, 10 });
+            table[1].push_back(3);
+            table.flush_async();
+        }
+        {
+            const auto table = mapped_static_vector_table<int, 4>::open(file.path);
+            CHECK(table[1].size() == 1);
+            CHECK(table[1][0] == 3);
+        }
+    }
+    SUBCASE("move")
+    {
+        temp_file file("dpm_mapped_table_move_test.bin");
+        auto table = mapped_static_vector_table<int, 2>::create(file.path, 1);
+        table[0].push_back(5);
+        auto moved = std::move(table);
+        CHECK(!table.is_open());
+        CHECK(moved.is_open());
+        CHECK(moved[0][0] == 5);
+        moved.close();
+        CHECK(!moved.is_open());
+    }
+    SUBCASE("layout mismatch")
+    {
+        temp_file file("dpm_mapped_table_mismatch_test.bin");
+        (void)mapped_static_vector_table<int, 4>::create(file.path, 2);
+
+        CHECK_THROWS_AS((void)(mapped_static_vector_table<int, 8>::open(file.path)), mapped_table_format_error);
+        CHECK_THROWS_AS((void)(mapped_static_vector_table<double, 4>::open(file.path)), mapped_table_format_error);
+    }
+    SUBCASE("not a table")
+    {
+        temp_file file("dpm_mapped_table_garbage_test.bin");
+        std::ofstream(file.path) << "definitely not a table, but long enough to hold a header";
+
+        CHECK_THROWS_AS((void)(mapped_static_vector_table<int, 4>::open(file.path)), mapped_table_format_error);
+    }
+    SUBCASE("corrupted record count")
+    {
+        temp_file file("dpm_mapped_table_count_test.bin");
+        (void)mapped_static_vector_table<int, 4>::create(file.path, 2);
+        {
+            // The record count follows the magic number, version and data offset. Chosen so that multiplying it by the
+            // record size wraps around to the real size of the file.
+            const std::uint64_t count = 2 + (std::uint64_t(1) << 62);
+            std::fstream stream(file.path, std::ios::in | std::ios::out | std::ios::binary);
+            stream.seekp(16);
+            stream.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        }
+
+        CHECK_THROWS_AS((void)(mapped_static_vector_table<int, 4>::open(file.path)), mapped_table_format_error);
+    }
+    SUBCASE("corrupted record size")
+    {
+        temp_file file("dpm_mapped_table_record_size_test.bin");
+        (void)mapped_static_vector_table<int, 4>::create(file.path, 2);
+        {
+            // The records are at the end of the file, and each one's size follows its four ints.
+            const auto records = std::filesystem::file_size(file.path) - 2 * sizeof(static_vector<int, 4>);
+            const char size = static_cast<char>(200);
+            std::fstream stream(file.path, std::ios::in | std::ios::out | std::ios::binary);
+            stream.seekp(static_cast<std::streamoff>(records + 4 * sizeof(int)));
+            stream.write(&size, 1);
+        }
+
+        CHECK_THROWS_AS((void)(mapped_static_vector_table<int, 4>::open(file.path)), mapped_table_format_error);
+    }
+    SUBCASE("missing file")
+    {
+        CHECK_THROWS_AS(
+            (void)(mapped_static_vector_table<int, 4>::open("/this/file/does/not/exist")), std::system_error);
+    }
+}
+
+#endif
@@ -0,0 +1,164 @@
+// Copyright (c) Daniel Marshall.
+// SPDX-License-Identifier: BSL-1.0
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <doctest/doctest.h>
+#include <dpm/parallel_algorithms.h>
+
+using namespace dpm;
+
+namespace
+{
+    constexpr std::size_t big = 100'000;
+
+    struct counted
+    {
+        inline static std::atomic<int> count = 0;
+        inline static std::atomic<int> throw_at = -1;
+        int value;
+
+        explicit counted(int v) : value(v)
+        {
+            if (v == throw_at)
+            {
+                throw std::runtime_error("counted");
+            }
+            ++count;
+        }
+        counted(const counted& other) : value(other.value) { ++count; }
+        ~counted() { --count; }
+    };
+
+    template <class T, std::size_t N>
+    auto make_big()
+    {
+        return std::make_unique<static_vector<T, N>>();
+    }
+}
+
+TEST_CASE("parallel algorithms")
+{
+    SUBCASE("transform_append")
+    {
+        std::vector<int> input(big);
+        std::iota(input.begin(), input.end(), 0);
+
+        auto sv = make_big<long long, big + 1>();
+        sv->push_back(-1);
+        transform_append(*sv, input.begin(), input.begin() + 10, [](int x) { return x * 2LL; });
+        CHECK(sv->size() == 11);
+        CHECK((*sv)[10] == 18);
+
+        sv->resize(1);
+#if defined(__cpp_lib_execution)
+        transform_append(std::execution::par, *sv, input.begin(), input.end(), [](int x) { return x * 2LL; });
+#else
+        transform_append(*sv, input.begin(), input.end(), [](int x) { return x * 2LL; });
+#endif
+        CHECK(sv->size() == big + 1);
+        CHECK((*sv)[0] == -1);
+        bool all_match = true;
+        for (std::size_t i = 0; i < big; ++i)
+        {
+            all_match = all_match && (*sv)[i + 1] == static_cast<long long>(i) * 2;
+        }
+        CHECK(all_match);
+    }
+    SUBCASE("generate_n_into")
+    {
+        auto sv = make_big<int, big>();
+        std::atomic<int> calls = 0;
+#if defined(__cpp_lib_execution)
+        generate_n_into(std::execution::par, *sv, big, [&] { return ++calls; });
+#else
+        generate_n_into(*sv, big, [&] { return ++calls; });
+#endif
+        CHECK(sv->size() == big);
+        CHECK(calls == static_cast<int>(big));
+        // Every value from the generator ends up in the vector exactly once.
+        std::vector<int> sorted(sv->begin(), sv->end());
+        std::sort(sorted.begin(), sorted.end());
+        CHECK(sorted.front() == 1);
+        CHECK(sorted.back() == static_cast<int>(big));
+        CHECK(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+    }
+    SUBCASE("reduce")
+    {
+        auto sv = make_big<int, big>();
+        generate_n_into(*sv, big, [i = 0]() mutable { return i++; });
+
+        const long long expected = static_cast<long long>(big) * (big - 1) / 2;
+        CHECK(reduce(*sv, 0LL) == expected);
+#if defined(__cpp_lib_execution)
+        CHECK(reduce(std::execution::par, *sv, 0LL) == expected);
+        CHECK(reduce(std::execution::seq, *sv, 0LL) == expected);
+        CHECK(reduce(std::execution::par, *sv, 0, [](int a, int b) { return std::max(a, b); }) == big - 1);
+#endif
+
+        static_vector<int, 4> empty;
+        CHECK(reduce(empty, 5) == 5);
+        static_vector<std::string, 4> strings{ "a", "b", "c" };
+        CHECK(reduce(strings).size() == 3);
+    }
+    SUBCASE("parallel_sort")
+    {
+        auto sv = make_big<int, big>();
+        std::mt19937 rng(42);
+        generate_n_into(*sv, big, [&] { return static_cast<int>(rng() % 1000); });
+
+#if defined(__cpp_lib_execution)
+        parallel_sort(std::execution::par, *sv);
+#else
+        parallel_sort(*sv);
+#endif
+        CHECK(sv->size() == big);
+        CHECK(std::is_sorted(sv->begin(), sv->end()));
+
+        parallel_sort(*sv, std::greater<>{});
+        CHECK(std::is_sorted(sv->begin(), sv->end(), std::greater<>{}));
+
+        static_vector<int, 5> small{ 3, 1, 2 };
+        parallel_sort(small);
+        CHECK(small == static_vector<int, 5>{ 1, 2, 3 });
+    }
+    SUBCASE("construction throws mid-fill")
+    {
+        std::vector<int> input(big);
+        std::iota(input.begin(), input.end(), 0);
+
+        auto sv = make_big<counted, big + 2>();
+        sv->emplace_back(-2);
+        sv->emplace_back(-3);
+        counted::throw_at = static_cast<int>(big * 3 / 4);
+
+#if defined(__cpp_lib_execution)
+        CHECK_THROWS_AS(transform_append(std::execution::par, *sv, input.begin(), input.end(),
+                            [](int x) { return counted(x); }),
+            std::runtime_error);
+#else
+        CHECK_THROWS_AS(transform_append(*sv, input.begin(), input.end(), [](int x) { return counted(x); }),
+            std::runtime_error);
+#endif
+        // Everything constructed before the failure (on any thread) was destroyed again.
+        CHECK(sv->size() == 2);
+        CHECK(counted::count == 2);
+        CHECK((*sv)[1].value == -3);
+
+        int next = 0;
+        CHECK_THROWS_AS(generate_n_into(*sv, big, [&] { return counted(next++); }), std::runtime_error);
+        CHECK(sv->size() == 2);
+        CHECK(counted::count == 2);
+
+        counted::throw_at = -1;
+        sv->clear();
+        CHECK(counted::count == 0);
+    }
+}
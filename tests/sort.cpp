@@ -0,0 +1,119 @@
+// Copyright (c) Daniel Marshall.
+// SPDX-License-Identifier: BSL-1.0
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <doctest/doctest.h>
+#include <dpm/sort.h>
+
+using namespace dpm;
+
+namespace
+{
+    template <class T, std::size_t N, class Compare = std::less<>>
+    bool sorts_like_std(std::mt19937& rng, std::size_t size, Compare comp = {})
+    {
+        static_vector<T, N> sv;
+        std::uniform_int_distribution<int> dist(-50, 50);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            sv.push_back(static_cast<T>(dist(rng)));
+        }
+        std::vector<T> expected(sv.begin(), sv.end());
+        std::sort(expected.begin(), expected.end(), comp);
+        dpm::sort(sv, comp);
+        return sv.size() == size && std::equal(sv.begin(), sv.end(), expected.begin(), expected.end());
+    }
+
+    template <std::size_t N>
+    bool sorts_every_size(std::mt19937& rng)
+    {
+        for (std::size_t size = 0; size <= N; ++size)
+        {
+            for (int i = 0; i < 20; ++i)
+            {
+                if (!sorts_like_std<int, N>(rng, size) || !sorts_like_std<double, N>(rng, size) ||
+                    !sorts_like_std<unsigned char, N>(rng, size) || !sorts_like_std<int, N>(rng, size, std::greater<>{}))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // By the 0-1 principle a comparator network sorts everything iff it sorts every sequence of 0s and 1s.
+    template <std::size_t N>
+    bool network_sorts_all_binary_inputs()
+    {
+        for (std::uint32_t bits = 0; bits < (1u << N); ++bits)
+        {
+            static_vector<int, N> sv;
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                sv.push_back((bits >> i) & 1);
+            }
+            dpm::sort(sv);
+            if (!std::is_sorted(sv.begin(), sv.end()))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST_CASE("sort")
+{
+    std::mt19937 rng(1234);
+
+    SUBCASE("sorting networks")
+    {
+        CHECK(network_sorts_all_binary_inputs<1>());
+        CHECK(network_sorts_all_binary_inputs<2>());
+        CHECK(network_sorts_all_binary_inputs<3>());
+        CHECK(network_sorts_all_binary_inputs<7>());
+        CHECK(network_sorts_all_binary_inputs<12>());
+        CHECK(network_sorts_all_binary_inputs<16>());
+
+        CHECK(sorts_every_size<1>(rng));
+        CHECK(sorts_every_size<5>(rng));
+        CHECK(sorts_every_size<8>(rng));
+        CHECK(sorts_every_size<13>(rng));
+        CHECK(sorts_every_size<32>(rng));
+    }
+    SUBCASE("sentinel values in the input")
+    {
+        static_vector<int, 8> ints{ std::numeric_limits<int>::max(), 3, std::numeric_limits<int>::min(), 3 };
+        dpm::sort(ints);
+        CHECK(ints == static_vector<int, 8>{ std::numeric_limits<int>::min(), 3, 3, std::numeric_limits<int>::max() });
+
+        constexpr auto inf = std::numeric_limits<double>::infinity();
+        static_vector<double, 8> doubles{ inf, -inf, 0.5 };
+        dpm::sort(doubles);
+        CHECK(doubles == static_vector<double, 8>{ -inf, 0.5, inf });
+    }
+    SUBCASE("insertion sort")
+    {
+        static_vector<std::string, 8> sv{ "pear", "apple", "fig", "banana" };
+        dpm::sort(sv);
+        CHECK(sv == static_vector<std::string, 8>{ "apple", "banana", "fig", "pear" });
+
+        dpm::sort(sv, [](const auto& a, const auto& b) { return a.size() < b.size(); });
+        CHECK(sv.front() == "fig");
+        CHECK(sv.back() == "banana");
+    }
+    SUBCASE("large capacities")
+    {
+        for (std::size_t size : { 0, 1, 33, 100, 500 })
+        {
+            CHECK(sorts_like_std<int, 500>(rng, size));
+            CHECK(sorts_like_std<long, 64>(rng, std::min<std::size_t>(size, 64)));
+        }
+    }
+}
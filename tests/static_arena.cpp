@@ -0,0 +1,107 @@
+// Copyright (c) Daniel Marshall.
+// SPDX-License-Identifier: BSL-1.0
+
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <doctest/doctest.h>
+#include <dpm/static_arena.h>
+
+using namespace dpm;
+
+namespace
+{
+    bool is_inside(const void* p, const void* arena, std::size_t size)
+    {
+        auto addr = reinterpret_cast<std::uintptr_t>(p);
+        auto begin = reinterpret_cast<std::uintptr_t>(arena);
+        return addr >= begin && addr < begin + size;
+    }
+}
+
+TEST_CASE("static_arena")
+{
+    SUBCASE("bump allocation")
+    {
+        static_arena<256> arena;
+        CHECK(arena.bytes_used() == 0);
+
+        void* a = arena.allocate(8, 8);
+        void* b = arena.allocate(8, 8);
+        CHECK(is_inside(a, &arena, sizeof(arena)));
+        CHECK(is_inside(b, &arena, sizeof(arena)));
+        CHECK(reinterpret_cast<std::uintptr_t>(b) % 8 == 0);
+        CHECK(static_cast<std::byte*>(b) > static_cast<std::byte*>(a));
+        CHECK(arena.bytes_used() >= 16);
+        CHECK(arena.fallback_hits() == 0);
+
+        // Freeing the most recent allocation gives its space back.
+        const auto used = arena.bytes_used();
+        arena.deallocate(b, 8, 8);
+        CHECK(arena.bytes_used() < used);
+        arena.deallocate(a, 8, 8);
+        CHECK(arena.bytes_used() == 0);
+        CHECK(arena.peak_bytes_used() == used);
+    }
+    SUBCASE("release")
+    {
+        static_arena<64> arena;
+        (void)arena.allocate(16, 4);
+        (void)arena.allocate(16, 4);
+        CHECK(arena.bytes_used() == 32);
+        CHECK(arena.bytes_remaining() == 32);
+        arena.release();
+        CHECK(arena.bytes_used() == 0);
+        CHECK(arena.peak_bytes_used() == 32);
+    }
+    SUBCASE("no upstream")
+    {
+        static_arena<16> arena;
+        (void)arena.allocate(16, 1);
+        CHECK_THROWS_AS((void)arena.allocate(1, 1), std::bad_alloc);
+    }
+    SUBCASE("fallback")
+    {
+        static_arena<32> arena(std::pmr::new_delete_resource());
+        void* inline_alloc = arena.allocate(24, 8);
+        void* fallback = arena.allocate(24, 8);
+        CHECK(is_inside(inline_alloc, &arena, sizeof(arena)));
+        CHECK(!is_inside(fallback, &arena, sizeof(arena)));
+        CHECK(arena.fallback_hits() == 1);
+        CHECK(arena.fallback_bytes() == 24);
+        arena.deallocate(fallback, 24, 8);
+        arena.deallocate(inline_alloc, 24, 8);
+        CHECK(arena.bytes_used() == 0);
+    }
+    SUBCASE("zero bytes when full")
+    {
+        static_arena<16> arena(std::pmr::new_delete_resource());
+        void* all = arena.allocate(16, 1);
+        void* empty = arena.allocate(0, 1);
+        CHECK(arena.fallback_hits() == 1);
+        // Goes back to the upstream resource, which would fail if it were given the end of the inline storage.
+        arena.deallocate(empty, 0, 1);
+        arena.deallocate(all, 16, 1);
+        CHECK(arena.bytes_used() == 0);
+    }
+    SUBCASE("pmr containers")
+    {
+        static_arena<1024> arena;
+        std::pmr::vector<int> vec(&arena);
+        vec.reserve(16);
+        for (int i = 0; i < 16; ++i)
+        {
+            vec.push_back(i);
+        }
+        CHECK(is_inside(vec.data(), &arena, sizeof(arena)));
+
+        std::pmr::string str("a string long enough to not use the small buffer", &arena);
+        CHECK(is_inside(str.data(), &arena, sizeof(arena)));
+        CHECK(arena.fallback_hits() == 0);
+        CHECK(arena.is_equal(arena));
+        CHECK(!arena.is_equal(*std::pmr::new_delete_resource()));
+    }
+}
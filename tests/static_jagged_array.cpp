@@ -0,0 +1,151 @@
+// Copyright (c) Daniel Marshall.
+// SPDX-License-Identifier: BSL-1.0
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+#include <doctest/doctest.h>
+#include <dpm/static_jagged_array.h>
+
+using namespace dpm;
+
+namespace
+{
+    struct counter
+    {
+        inline static int count = 0;
+        int value = 0;
+        counter(int v = 0) noexcept : value(v) { ++count; }
+        counter(const counter& other) noexcept : value(other.value) { ++count; }
+        counter(counter&& other) noexcept : value(other.value) { ++count; }
+        counter& operator=(const counter&) noexcept = default;
+        counter& operator=(counter&&) noexcept = default;
+        ~counter() { --count; }
+    };
+
+    template <class Row, class T>
+    bool row_equals(Row row, std::initializer_list<T> expected)
+    {
+        return std::equal(row.begin(), row.end(), expected.begin(), expected.end());
+    }
+}
+
+static_assert(sizeof(static_jagged_array<int, 64, 8>) < sizeof(static_vector<static_vector<int, 8>, 8>));
+static_assert(std::is_trivially_copyable_v<static_jagged_array<int, 64, 8>>);
+static_assert(!std::is_trivially_copyable_v<static_jagged_array<std::string, 64, 8>>);
+
+TEST_CASE("static_jagged_array")
+{
+    SUBCASE("append rows")
+    {
+        static_jagged_array<int, 16, 4> ja;
+        CHECK(ja.empty());
+        CHECK(ja.rows() == 0);
+        CHECK(ja.size() == 0);
+
+        ja.append_row({ 1, 2, 3 });
+        ja.append_row();
+        std::vector<int> third{ 4, 5 };
+        auto row = ja.append_row(third);
+        CHECK(row.size() == 2);
+
+        CHECK(ja.rows() == 3);
+        CHECK(ja.size() == 5);
+        CHECK(row_equals(ja[0], { 1, 2, 3 }));
+        CHECK(ja[1].empty());
+        CHECK(row_equals(ja[2], { 4, 5 }));
+        CHECK(row_equals(ja.elements(), { 1, 2, 3, 4, 5 }));
+
+        decltype(auto) appended = ja.append_to_last_row(6);
+        CHECK(std::is_same_v<decltype(appended), int&>);
+        CHECK(row_equals(ja.back(), { 4, 5, 6 }));
+
+        ja.append_row();
+        ja.append_to_last_row(7);
+        CHECK(ja.rows() == 4);
+        CHECK(row_equals(ja.back(), { 7 }));
+        CHECK(row_equals(ja.elements(), { 1, 2, 3, 4, 5, 6, 7 }));
+
+        // Rows are views into the shared buffer.
+        ja[0][1] = 20;
+        CHECK(ja.elements()[1] == 20);
+
+        const auto& cja = ja;
+        CHECK(std::is_same_v<decltype(cja[0]), std::span<const int>>);
+        CHECK(row_equals(cja.front(), { 1, 20, 3 }));
+    }
+    SUBCASE("erase_row")
+    {
+        static_jagged_array<std::string, 16, 4> ja;
+        ja.append_row({ "a", "b" });
+        ja.append_row({ "c" });
+        ja.append_row({ "d", "e", "f" });
+        ja.append_row();
+
+        ja.erase_row(1);
+        CHECK(ja.rows() == 3);
+        CHECK(ja.size() == 5);
+        CHECK(row_equals(ja[0], { "a", "b" }));
+        CHECK(row_equals(ja[1], { "d", "e", "f" }));
+        CHECK(ja[2].empty());
+
+        ja.erase_row(0);
+        CHECK(row_equals(ja[0], { "d", "e", "f" }));
+        CHECK(ja.size() == 3);
+
+        ja.erase_row(1);
+        CHECK(ja.rows() == 1);
+        ja.pop_row();
+        CHECK(ja.empty());
+        CHECK(ja.size() == 0);
+    }
+    SUBCASE("lifetimes")
+    {
+        {
+            static_jagged_array<counter, 8, 4> ja;
+            ja.append_row({ 1, 2 });
+            ja.append_row({ 3 });
+            CHECK(counter::count == 3);
+
+            ja.erase_row(0);
+            CHECK(counter::count == 1);
+            CHECK(ja[0][0].value == 3);
+
+            ja.append_row({ 4, 5 });
+            auto copy = ja;
+            CHECK(counter::count == 6);
+            CHECK(copy[1][1].value == 5);
+
+            auto moved = std::move(copy);
+            CHECK(copy.empty());
+            CHECK(counter::count == 6);
+
+            moved.pop_row();
+            CHECK(counter::count == 4);
+
+            ja = moved;
+            CHECK(counter::count == 2);
+            CHECK(ja.rows() == 1);
+        }
+        CHECK(counter::count == 0);
+    }
+    SUBCASE("copy/move")
+    {
+        static_jagged_array<std::string, 8, 3> ja;
+        ja.append_row({ "x", "y" });
+        ja.append_row({ "z" });
+
+        static_jagged_array<std::string, 8, 3> other;
+        other.append_row({ "q" });
+        other = ja;
+        CHECK(row_equals(other[0], { "x", "y" }));
+        CHECK(row_equals(other[1], { "z" }));
+
+        static_jagged_array<std::string, 8, 3> moved;
+        moved = std::move(other);
+        CHECK(other.empty());
+        CHECK(row_equals(moved.elements(), { "x", "y", "z" }));
+    }
+}
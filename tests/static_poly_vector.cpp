@@ -0,0 +1,193 @@
+// Copyright (c) Daniel Marshall.
+// SPDX-License-Identifier: BSL-1.0
+
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include <doctest/doctest.h>
+#include <dpm/static_poly_vector.h>
+
+using namespace dpm;
+
+namespace
+{
+    struct shape
+    {
+        inline static int count = 0;
+        shape() noexcept { ++count; }
+        shape(const shape&) noexcept { ++count; }
+        shape(shape&&) noexcept { ++count; }
+        virtual ~shape() { --count; }
+
+        virtual int area() const = 0;
+    };
+
+    struct square : shape
+    {
+        int side;
+        explicit square(int s) : side(s) {}
+        int area() const override { return side * side; }
+    };
+
+    struct rectangle : shape
+    {
+        int width;
+        int height;
+        std::string name;
+        rectangle(int w, int h, std::string n = "rect") : width(w), height(h), name(std::move(n)) {}
+        int area() const override { return width * height; }
+    };
+
+    struct tagged
+    {
+        char tag = 't';
+    };
+
+    // shape isn't the first base, so the Base subobject isn't at the start of the slot.
+    struct offset_square : tagged, square
+    {
+        using square::square;
+    };
+
+    struct throwing_move : shape
+    {
+        inline static bool do_throw = false;
+        throwing_move() = default;
+        throwing_move(throwing_move&& other) : shape(std::move(other))
+        {
+            if (do_throw)
+            {
+                throw 42;
+            }
+        }
+        int area() const override { return -1; }
+    };
+
+    using shapes = static_poly_vector<shape, 4, 64, alignof(std::max_align_t)>;
+}
+
+static_assert(std::ranges::random_access_range<shapes>);
+static_assert(std::ranges::random_access_range<const shapes>);
+static_assert(std::is_same_v<std::ranges::range_reference_t<shapes>, shape&>);
+static_assert(std::is_same_v<std::ranges::range_reference_t<const shapes>, const shape&>);
+static_assert(!std::is_copy_constructible_v<shapes>);
+static_assert(std::is_move_constructible_v<shapes>);
+static_assert(shapes::fits<rectangle>);
+static_assert(!shapes::fits<std::string>);
+static_assert(!static_poly_vector<shape, 4, sizeof(square)>::fits<rectangle>);
+
+TEST_CASE("static_poly_vector")
+{
+    SUBCASE("emplace_back/iteration")
+    {
+        shapes sv;
+        CHECK(sv.empty());
+        decltype(auto) sq = sv.emplace_back<square>(3);
+        sv.emplace_back<rectangle>(2, 5);
+        sv.emplace_back<offset_square>(4);
+
+        CHECK(std::is_same_v<decltype(sq), square&>);
+        CHECK(sv.size() == 3);
+        CHECK(sv[0].area() == 9);
+        CHECK(sv[1].area() == 10);
+        CHECK(sv[2].area() == 16);
+        CHECK(sv.front().area() == 9);
+        CHECK(sv.back().area() == 16);
+
+        int total = 0;
+        for (const shape& s : sv)
+        {
+            total += s.area();
+        }
+        CHECK(total == 35);
+        CHECK(std::distance(sv.rbegin(), sv.rend()) == 3);
+        CHECK(sv.rbegin()->area() == 16);
+    }
+    SUBCASE("elements are stored inline")
+    {
+        shapes sv;
+        sv.emplace_back<square>(1);
+        sv.emplace_back<square>(2);
+        auto* first = reinterpret_cast<const std::byte*>(&sv[0]);
+        auto* second = reinterpret_cast<const std::byte*>(&sv[1]);
+        CHECK(second - first == static_cast<std::ptrdiff_t>(shapes::slot_size()));
+        CHECK(first >= reinterpret_cast<const std::byte*>(&sv));
+        CHECK(first < reinterpret_cast<const std::byte*>(&sv) + sizeof(sv));
+    }
+    SUBCASE("destruction")
+    {
+        {
+            shapes sv;
+            sv.emplace_back<square>(1);
+            sv.emplace_back<rectangle>(1, 2);
+            CHECK(shape::count == 2);
+            sv.pop_back();
+            CHECK(shape::count == 1);
+            CHECK(sv.size() == 1);
+            sv.emplace_back<offset_square>(3);
+        }
+        CHECK(shape::count == 0);
+    }
+    SUBCASE("move")
+    {
+        shapes sv1;
+        sv1.emplace_back<square>(2);
+        sv1.emplace_back<rectangle>(3, 4, "a fairly long name that won't fit in the small buffer");
+        sv1.emplace_back<offset_square>(5);
+
+        shapes sv2 = std::move(sv1);
+        CHECK(sv1.empty());
+        CHECK(sv2.size() == 3);
+        CHECK(sv2[0].area() == 4);
+        CHECK(sv2[1].area() == 12);
+        CHECK(static_cast<rectangle&>(sv2[1]).name == "a fairly long name that won't fit in the small buffer");
+        CHECK(sv2[2].area() == 25);
+        CHECK(shape::count == 3);
+
+        shapes sv3;
+        sv3.emplace_back<square>(7);
+        sv3 = std::move(sv2);
+        CHECK(sv2.empty());
+        CHECK(sv3.size() == 3);
+        CHECK(sv3[2].area() == 25);
+        CHECK(shape::count == 3);
+
+        sv3.clear();
+        CHECK(sv3.empty());
+        CHECK(shape::count == 0);
+    }
+    SUBCASE("erase")
+    {
+        shapes sv;
+        sv.emplace_back<square>(1);
+        sv.emplace_back<rectangle>(2, 3);
+        sv.emplace_back<offset_square>(4);
+
+        auto it = sv.erase(sv.begin());
+        CHECK(it == sv.begin());
+        CHECK(sv.size() == 2);
+        CHECK(sv[0].area() == 6);
+        CHECK(sv[1].area() == 16);
+        CHECK(shape::count == 2);
+
+        it = sv.erase(sv.begin() + 1);
+        CHECK(it == sv.end());
+        CHECK(sv.size() == 1);
+        CHECK(shape::count == 1);
+    }
+    SUBCASE("throwing move")
+    {
+        {
+            shapes sv1;
+            sv1.emplace_back<throwing_move>();
+            sv1.emplace_back<throwing_move>();
+            throwing_move::do_throw = true;
+            CHECK_THROWS_AS(shapes(std::move(sv1)), int);
+            throwing_move::do_throw = false;
+            CHECK(sv1.size() == 2);
+            CHECK(shape::count == 2);
+        }
+        CHECK(shape::count == 0);
+    }
+}
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include <array>
+#include <set>
+#include <stdexcept>
 #include <string>
 
 #include <doctest/doctest.h>
@@ -44,7 +46,7 @@ struct copy_move_tester
     }
     copy_move_tester& operator=(copy_move_tester&& other)
     {
-        data = std::exchange(other.data, nullptr);
+        std::swap(data, other.data);
         return *this;
     }
 
@@ -54,6 +56,45 @@ struct copy_move_tester
     const int* addr() const { return data; }
 };
 
+// Tracks which objects are alive, and its move constructor throws once moves_until_throw reaches 0.
+struct throwing_mover
+{
+    inline static std::set<const throwing_mover*> alive;
+    inline static int moves_until_throw = -1;
+    int value = 0;
+
+    throwing_mover(int v) : value(v) { alive.insert(this); }
+    throwing_mover(const throwing_mover& other) : value(other.value) { alive.insert(this); }
+    throwing_mover(throwing_mover&& other) : value(other.value)
+    {
+        if (moves_until_throw >= 0 && moves_until_throw-- == 0)
+        {
+            throw std::runtime_error("move");
+        }
+        alive.insert(this);
+    }
+    ~throwing_mover() { CHECK(alive.erase(this) == 1); }
+
+    throwing_mover& operator=(const throwing_mover&) = default;
+    throwing_mover& operator=(throwing_mover&&) = default;
+
+    // Every element is alive and nothing else is.
+    template <class A, class B>
+    static bool only_alive(const A& a, const B& b)
+    {
+        std::set<const throwing_mover*> expected;
+        for (const auto& x : a)
+        {
+            expected.insert(&x);
+        }
+        for (const auto& x : b)
+        {
+            expected.insert(&x);
+        }
+        return expected == alive;
+    }
+};
+
 struct copy_only
 {
     copy_only() = default;
@@ -99,6 +140,15 @@ TEST_CASE("constructors/destructors")
 
         CHECK(sv_0 == moved_sv[0].addr());
         CHECK(sv_1 == moved_sv[1].addr());
+
+        {
+            static_vector<object_counter, 3> counters(3);
+            auto moved_counters = std::move(counters);
+            // The moved from elements are destroyed, not left alive in the source.
+            CHECK(counters.empty());
+            CHECK(object_counter::count == 3);
+        }
+        CHECK(object_counter::count == 0);
     }
     SUBCASE("static_vector(size_type)")
     {
@@ -152,6 +202,12 @@ TEST_CASE("assignment")
         CHECK(sv1[0].value() == 2);
         CHECK(sv2[0].value() == 2);
 
+        static_vector<copy_move_tester, 3> sv5{ 3, 4, 5 };
+        sv2 = sv5;
+        CHECK(sv2.size() == 3);
+        CHECK(sv2[0].value() == 3);
+        CHECK(sv2[2].value() == 5);
+
         {
             static_vector<object_counter, 3> sv3{ {}, {}, {} };
             static_vector<object_counter, 3> sv4{ {} };
@@ -197,6 +253,23 @@ TEST_CASE("assignment")
         CHECK(sv1.size() == 1);
         CHECK(sv2.size() == 1);
         CHECK(sv1[0].value() == sv2[0].value());
+
+        static_vector<copy_move_tester, 3> sv3{ 5, 6, 7 };
+        sv2.assign(sv3.begin(), sv3.end());
+        CHECK(sv2.size() == 3);
+        CHECK(sv2[0].value() == 5);
+        CHECK(sv2[1].value() == 6);
+        CHECK(sv2[2].value() == 7);
+        CHECK(sv2[2].addr() != sv3[2].addr());
+
+        {
+            static_vector<object_counter, 3> counters(1);
+            static_vector<object_counter, 3> more(3);
+            counters.assign(more.begin(), more.end());
+            CHECK(counters.size() == 3);
+            CHECK(object_counter::count == 6);
+        }
+        CHECK(object_counter::count == 0);
     }
     SUBCASE("assign(n, value)")
     {
@@ -212,6 +285,19 @@ TEST_CASE("assignment")
         CHECK(sv[0].value() == 10);
         CHECK(sv[1].value() == 10);
         CHECK(sv[2].value() == 10);
+
+        sv.assign(1, 20);
+        CHECK(sv.size() == 1);
+        CHECK(sv[0].value() == 20);
+
+        {
+            const object_counter value;
+            static_vector<object_counter, 3> counters(3);
+            counters.assign(1, value);
+            CHECK(counters.size() == 1);
+            CHECK(object_counter::count == 2);
+        }
+        CHECK(object_counter::count == 0);
     }
 }
 
@@ -441,3 +527,170 @@ TEST_CASE("ranges")
         }
     }
 }
+
+TEST_CASE("cross-capacity")
+{
+    SUBCASE("converting construction")
+    {
+        static_vector<int, 3> small{ 1, 2, 3 };
+        static_vector<int, 5> copied = small;
+        CHECK(copied.size() == 3);
+        CHECK(copied[2] == 3);
+        CHECK(small.size() == 3);
+
+        static_vector<copy_move_tester, 2> sv{ 1, 2 };
+        const auto* sv_0 = sv[0].addr();
+        static_vector<copy_move_tester, 4> moved = std::move(sv);
+        CHECK(moved.size() == 2);
+        CHECK(moved[0].addr() == sv_0);
+        CHECK(sv.empty());
+
+        CHECK(std::is_constructible_v<static_vector<int, 5>, const static_vector<int, 3>&>);
+        CHECK(!std::is_constructible_v<static_vector<int, 3>, const static_vector<int, 5>&>);
+        CHECK(!std::is_constructible_v<static_vector<int, 3>, static_vector<int, 5>&&>);
+    }
+    SUBCASE("converting assignment")
+    {
+        static_vector<std::string, 2> small{ "a", "b" };
+        static_vector<std::string, 4> large{ "x", "y", "z" };
+        large = small;
+        CHECK(large == static_vector<std::string, 4>{ "a", "b" });
+
+        large = std::move(small);
+        CHECK(large == static_vector<std::string, 4>{ "a", "b" });
+        CHECK(small.empty());
+
+        {
+            static_vector<object_counter, 2> counters(2);
+            static_vector<object_counter, 3> more(3);
+            CHECK(object_counter::count == 5);
+            more = std::move(counters);
+            CHECK(object_counter::count == 2);
+            CHECK(counters.empty());
+        }
+        CHECK(object_counter::count == 0);
+
+        CHECK(!std::is_assignable_v<static_vector<int, 3>&, const static_vector<int, 5>&>);
+    }
+    SUBCASE("splice")
+    {
+        {
+            static_vector<int, 8> sv{ 1, 2, 6 };
+            static_vector<int, 5> other{ 0, 3, 4, 5, 7 };
+            auto it = sv.splice(sv.begin() + 2, other, other.begin() + 1, other.begin() + 4);
+            CHECK(it == sv.begin() + 2);
+            CHECK(sv == static_vector<int, 8>{ 1, 2, 3, 4, 5, 6 });
+            CHECK(other == static_vector<int, 5>{ 0, 7 });
+        }
+        {
+            static_vector<copy_move_tester, 6> sv{ 1, 4 };
+            static_vector<copy_move_tester, 6> other{ 2, 3, 5 };
+            const auto* addr_2 = other[0].addr();
+            sv.splice(sv.begin() + 1, other, other.begin(), other.begin() + 2);
+            CHECK(sv.size() == 4);
+            CHECK(sv[0].value() == 1);
+            CHECK(sv[1].value() == 2);
+            CHECK(sv[1].addr() == addr_2);
+            CHECK(sv[2].value() == 3);
+            CHECK(sv[3].value() == 4);
+            CHECK(other.size() == 1);
+            CHECK(other[0].value() == 5);
+        }
+        {
+            static_vector<object_counter, 6> sv(2);
+            static_vector<object_counter, 3> other(3);
+            sv.splice(sv.begin(), other);
+            CHECK(sv.size() == 5);
+            CHECK(other.empty());
+            CHECK(object_counter::count == 5);
+        }
+        CHECK(object_counter::count == 0);
+    }
+    SUBCASE("throwing moves")
+    {
+        {
+            static_vector<throwing_mover, 6> sv{ 1 };
+            static_vector<throwing_mover, 3> other{ 2, 3, 4 };
+            throwing_mover::moves_until_throw = 1;
+            CHECK_THROWS_AS(sv.splice(sv.end(), other), std::runtime_error);
+            throwing_mover::moves_until_throw = -1;
+            CHECK(sv.size() == 1);
+            CHECK(other.size() == 3);
+            CHECK(throwing_mover::only_alive(sv, other));
+
+            sv.splice(sv.begin(), other, other.begin() + 1, other.end());
+            CHECK(sv.size() == 3);
+            CHECK(sv[0].value == 3);
+            CHECK(sv[1].value == 4);
+            CHECK(sv[2].value == 1);
+            CHECK(other.size() == 1);
+            CHECK(other[0].value == 2);
+            CHECK(throwing_mover::only_alive(sv, other));
+
+            throwing_mover::moves_until_throw = 1;
+            CHECK_THROWS_AS((void)sv.split_at(sv.begin()), std::runtime_error);
+            throwing_mover::moves_until_throw = -1;
+            CHECK(sv.size() == 3);
+            CHECK(throwing_mover::only_alive(sv, other));
+
+            auto tail = sv.split_at<2>(sv.begin() + 1);
+            CHECK(sv.size() == 1);
+            CHECK(tail.size() == 2);
+            CHECK(tail[1].value == 1);
+
+            throwing_mover::moves_until_throw = 1;
+            CHECK_THROWS_AS((static_vector<throwing_mover, 4>(std::move(tail))), std::runtime_error);
+            throwing_mover::moves_until_throw = -1;
+            CHECK(tail.size() == 2);
+            other.clear();
+            CHECK(throwing_mover::only_alive(sv, tail));
+
+            static_vector<throwing_mover, 4> moved(std::move(tail));
+            CHECK(moved.size() == 2);
+            CHECK(tail.empty());
+            CHECK(throwing_mover::only_alive(sv, moved));
+        }
+        CHECK(throwing_mover::alive.empty());
+    }
+    SUBCASE("move_append")
+    {
+        static_vector<std::string, 6> sv{ "a" };
+        static_vector<std::string, 3> other{ "b", "c" };
+        sv.move_append(other);
+        CHECK(sv == static_vector<std::string, 6>{ "a", "b", "c" });
+        CHECK(other.empty());
+    }
+    SUBCASE("split_at")
+    {
+        static_vector<std::string, 5> sv{ "a", "b", "c", "d" };
+        auto tail = sv.split_at(sv.begin() + 1);
+        CHECK(std::is_same_v<decltype(tail), static_vector<std::string, 5>>);
+        CHECK(sv == static_vector<std::string, 5>{ "a" });
+        CHECK(tail == static_vector<std::string, 5>{ "b", "c", "d" });
+
+        auto small_tail = tail.split_at<2>(tail.begin() + 1);
+        CHECK(std::is_same_v<decltype(small_tail), static_vector<std::string, 2>>);
+        CHECK(small_tail == static_vector<std::string, 2>{ "c", "d" });
+        CHECK(tail.size() == 1);
+
+        static_vector<int, 3> ints{ 1, 2, 3 };
+        auto none = ints.split_at(ints.end());
+        CHECK(none.empty());
+        CHECK(ints.size() == 3);
+    }
+    SUBCASE("concat")
+    {
+        static_vector<int, 2> a{ 1, 2 };
+        static_vector<int, 3> b{ 3 };
+        auto joined = concat(a, b);
+        CHECK(std::is_same_v<decltype(joined), static_vector<int, 5>>);
+        CHECK(joined == static_vector<int, 5>{ 1, 2, 3 });
+
+        static_vector<std::string, 1> x{ "x" };
+        static_vector<std::string, 2> y{ "y", "z" };
+        auto moved = concat(std::move(x), std::move(y));
+        CHECK(moved == static_vector<std::string, 3>{ "x", "y", "z" });
+        CHECK(x.empty());
+        CHECK(y.empty());
+    }
+}